@@ -0,0 +1,53 @@
+#include "AttackTable.h"
+#include <atomic>
+#include <mutex>
+
+AttackTable::AttackTable(int boardSize)
+    : n(boardSize)
+{
+    lines.resize((static_cast<size_t>(n) * n + 7) / 8);
+    masks = lines.data()->words;
+
+    // distance 0 is the queen's own row, nothing to attack there
+    for (int col = 0; col < n; col++)
+    {
+        masks[col] = 0;
+    }
+
+    for (int distance = 1; distance < n; distance++)
+    {
+        for (int col = 0; col < n; col++)
+        {
+            // column
+            uint64_t mask = 1ULL << col;
+
+            // diagonals
+            if (col + distance < n)
+                mask |= 1ULL << (col + distance);
+            if (col - distance >= 0)
+                mask |= 1ULL << (col - distance);
+
+            masks[distance * n + col] = mask;
+        }
+    }
+}
+
+const AttackTable &AttackTable::get(int n)
+{
+    // one slot per supported board size, tables live until the program exits
+    static std::atomic<const AttackTable *> tables[65];
+    static std::mutex buildMutex;
+
+    const AttackTable *table = tables[n].load(std::memory_order_acquire);
+    if (table)
+        return *table;
+
+    std::lock_guard<std::mutex> lock(buildMutex);
+    table = tables[n].load(std::memory_order_relaxed);
+    if (!table)
+    {
+        table = new AttackTable(n);
+        tables[n].store(table, std::memory_order_release);
+    }
+    return *table;
+}
@@ -0,0 +1,43 @@
+#ifndef ATTACKTABLE_H
+#define ATTACKTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+// columns a queen attacks in another row, shared by every domain based solver
+// the mask only depends on how far apart the rows are and the queen's column, so it's stored flat as
+// masks[distance * n + col], n^2 words instead of the old per solver n^3 vectors (32KB at n = 64, fits L1)
+// built once per board size, then read only, so every solver and thread uses the same copy
+class AttackTable
+{
+private:
+    // aligned storage, the table starts on a cache line
+    struct alignas(64) CacheLine
+    {
+        uint64_t words[8];
+    };
+
+    int n;
+    std::vector<CacheLine> lines;
+    uint64_t *masks;
+
+    explicit AttackTable(int boardSize);
+
+public:
+    // the table for board size n, built on first use, safe to call from any thread
+    static const AttackTable &get(int n);
+
+    // columns in r2 attacked by a queen at (r1, col), 0 when r1 == r2
+    uint64_t mask(int r1, int r2, int col) const
+    {
+        int distance = r1 > r2 ? r1 - r2 : r2 - r1;
+        return masks[distance * n + col];
+    }
+
+    uint64_t atDistance(int distance, int col) const
+    {
+        return masks[distance * n + col];
+    }
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include "BTBitsSolver.h"
+#include "Symmetry.h"
+#include "SearchLimit.h"
+
+BTBitsSolver::BTBitsSolver(int boardSize, const Solution &initial, int maxDepth, WorkPool *wp, const SolverOptions &opts)
+    : n(boardSize), initialState(initial), recorder(opts), maxDepth(maxDepth), workPool(wp), options(opts)
+{
+    frames.resize(n);
+    allowed.resize(n);
+}
+
+void BTBitsSolver::reset(const Solution &initial)
+{
+    initialState = initial;
+}
+
+// hands the shallowest untried column to the pool, same as the engine's takeShallowest (SearchTrail.h)
+// the top frame is the one being worked on, so it's left alone
+bool BTBitsSolver::donate(int depth, int startRow)
+{
+    for (int d = 0; d < depth; d++)
+    {
+        uint64_t avail = frames[d].avail;
+        if (avail == 0)
+            continue;
+
+        // we take columns lowest first, so give away the highest one, it's the last we'd get to
+        int col = 63 - __builtin_clzll(avail);
+        frames[d].avail &= ~(1ULL << col);
+
+        int row = startRow + d;
+        Solution donated(n, -1);
+        for (int i = 0; i < row; i++)
+        {
+            donated[i] = board[i];
+        }
+        donated[row] = col;
+
+        workPool->push(donated);
+        return true;
+    }
+    return false;
+}
+
+// the search proper, from frames[0] (row startRow) down
+template <bool Limited>
+void BTBitsSolver::search(int startRow, uint64_t full)
+{
+    const uint64_t *rowAllowed = allowed.data() + startRow;
+    int depth = 0;
+    while (depth >= 0)
+    {
+        if (workPool && maxDepth == 0 && workPool->wantsWork())
+            donate(depth, startRow);
+
+        BitsFrame &frame = frames[depth];
+        if (frame.avail == 0)
+        {
+            // only checked on the way back up, keeps it off the descent path
+            if (Limited && options.limit->stopRequested())
+                break;
+
+            depth--;
+            continue;
+        }
+
+        // lowest free column, same order as the other solvers
+        uint64_t bit = frame.avail & -frame.avail;
+        frame.avail ^= bit;
+
+        int row = startRow + depth;
+        board[row] = __builtin_ctzll(bit);
+
+        if (row + 1 == maxDepth)
+        {
+            Solution seed = board;
+            for (int i = row + 1; i < n; i++)
+            {
+                seed[i] = -1;
+            }
+            workPool->pushSeed(seed);
+            continue;
+        }
+
+        if (row + 1 == n)
+        {
+            recorder.record(board);
+            continue;
+        }
+
+        BitsFrame &next = frames[depth + 1];
+        next.cols = frame.cols | bit;
+        next.ld = ((frame.ld | bit) << 1) & full;
+        next.rd = (frame.rd | bit) >> 1;
+        next.avail = ~(next.cols | next.ld | next.rd) & rowAllowed[depth + 1];
+        depth++;
+    }
+}
+
+void BTBitsSolver::solve()
+{
+    const uint64_t full = n == 64 ? ~0ULL : (1ULL << n) - 1;
+
+    // rebuild the masks from the assigned prefix, seeds and donations are always a prefix
+    board = initialState;
+    uint64_t cols = 0, ld = 0, rd = 0;
+    int startRow = 0;
+    while (startRow < n && board[startRow] != -1)
+    {
+        uint64_t bit = 1ULL << board[startRow];
+        cols |= bit;
+        ld = ((ld | bit) << 1) & full;
+        rd = (rd | bit) >> 1;
+        startRow++;
+    }
+
+    // nothing left to place, the state itself is the answer (or the seed)
+    if (startRow == n || (maxDepth > 0 && startRow == maxDepth))
+    {
+        if (maxDepth > 0 && startRow == maxDepth)
+            workPool->pushSeed(board);
+        else
+            recorder.record(board);
+
+        recorder.flush();
+        return;
+    }
+
+    uint64_t rootAvail = ~(cols | ld | rd) & full;
+    if (startRow == 0)
+        rootAvail &= firstRowMask(n, options.symmetry);
+
+    bool canonical = (options.symmetry == SymmetryMode::Full);
+    if (canonical && startRow == 0 && n > 1 && maxDepth == 0)
+    {
+        // what the rows below may take depends on row 0's column, so row 0 gets branched on out here
+        while (rootAvail && !(options.limit && options.limit->stopRequested()))
+        {
+            uint64_t bit = rootAvail & -rootAvail;
+            rootAvail ^= bit;
+            board[0] = __builtin_ctzll(bit);
+
+            for (int row = 0; row < n; row++)
+            {
+                allowed[row] = canonicalRowMask<uint64_t>(n, board[0], row);
+            }
+            frames[0] = {bit, (bit << 1) & full, bit >> 1, ~(bit | (bit << 1) | (bit >> 1)) & allowed[1]};
+            run(1, full);
+        }
+    }
+    else
+    {
+        for (int row = 0; row < n; row++)
+        {
+            allowed[row] = (canonical && startRow > 0) ? canonicalRowMask<uint64_t>(n, board[0], row) : full;
+        }
+        frames[0] = {cols, ld, rd, rootAvail & allowed[startRow]};
+        run(startRow, full);
+    }
+
+    recorder.flush();
+}
+
+void BTBitsSolver::run(int startRow, uint64_t full)
+{
+    // the limit check costs BT-BITS a few percent even when there's no limit, so runs without one get a loop without it
+    if (options.limit)
+        search<true>(startRow, full);
+    else
+        search<false>(startRow, full);
+}
+
+uint64_t BTBitsSolver::getSolutionCount() const
+{
+    return recorder.getSolutionCount();
+}
+
+uint64_t BTBitsSolver::getUniqueCount() const
+{
+    return recorder.getUniqueCount();
+}
+
+std::chrono::high_resolution_clock::time_point BTBitsSolver::getFirstSolutionTime() const
+{
+    return recorder.getFirstSolutionTime();
+}
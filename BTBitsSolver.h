@@ -0,0 +1,52 @@
+#ifndef BTBITSSOLVER_H
+#define BTBITSSOLVER_H
+
+#include "Solver.h"
+#include "WorkPool.h"
+#include "SolutionRecorder.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// one frame per row, everything the row needs is in three masks, no board copies
+struct BitsFrame
+{
+    uint64_t cols;  // columns taken by rows above
+    uint64_t ld;    // left diagonals hitting this row
+    uint64_t rd;    // right diagonals hitting this row
+    uint64_t avail; // columns still left to try in this row
+};
+
+// plain backtracking, the same search as the engine's BT (NoPropagation + StaticOrder, see SearchEngine.h),
+// but a row's free columns come from three running masks instead of the placed queens' attack masks
+// the board is only written in place, the frame stack is allocated once per solver
+class BTBitsSolver : public Solver
+{
+private:
+    int n;
+    Solution initialState;
+    SolutionRecorder recorder;
+    int maxDepth;
+    WorkPool *workPool;
+    SolverOptions options;
+
+    // search state, kept between seeds so reset() + solve() reuses the allocations
+    Solution board;
+    std::vector<BitsFrame> frames;
+    std::vector<uint64_t> allowed; // columns each row may take, all of them unless full symmetry cuts them (canonicalRowMask)
+
+    bool donate(int depth, int startRow);
+    template <bool Limited>
+    void search(int startRow, uint64_t full);
+    void run(int startRow, uint64_t full);
+
+public:
+    BTBitsSolver(int boardSize, const Solution &initial, int maxDepth = 0, WorkPool *wp = nullptr, const SolverOptions &opts = SolverOptions());
+    void solve() override;
+    void reset(const Solution &initial) override;
+    uint64_t getSolutionCount() const override;
+    uint64_t getUniqueCount() const override;
+    std::chrono::high_resolution_clock::time_point getFirstSolutionTime() const override;
+};
+
+#endif
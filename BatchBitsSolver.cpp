@@ -0,0 +1,436 @@
+#include "BatchBitsSolver.h"
+#include "Symmetry.h"
+#include "SearchLimit.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// ---- lane kernels ----
+// every step, each live lane either takes its lowest free column and goes a row down (push),
+// or has nothing left and goes a row back up (pop), the choice is a mask so no lane ever branches
+// a kernel returns as soon as a lane finds a solution or runs out of work, or after budget steps so the solver can donate
+// returns the lanes that ran out of work, solutions gets the lanes that are sitting on a full board
+// stacks[-width, 0) has to be writable, empty lanes (depth -1) may store there
+
+using BatchKernelFn = uint64_t (*)(BatchLanes &, uint64_t *, uint64_t, int, uint64_t &);
+
+static constexpr uint64_t low32 = 0xFFFFFFFFULL;
+
+static uint64_t batchKernelScalar(BatchLanes &lanes, uint64_t *stacks, uint64_t full, int budget, uint64_t &solutions)
+{
+    constexpr int width = 4;
+    uint64_t finished = 0;
+    solutions = 0;
+
+    for (int step = 0; step < budget; step++)
+    {
+        for (int lane = 0; lane < width; lane++)
+        {
+            int64_t depth = lanes.depth[lane];
+            if (depth < 0)
+                continue;
+
+            uint64_t avail = lanes.avail[lane];
+            if (avail)
+            {
+                uint64_t bit = avail & -avail;
+                stacks[depth * width + lane] = (bit << 32) | (avail ^ bit);
+
+                uint64_t cols = lanes.cols[lane] | bit;
+                uint64_t ld = (lanes.ld[lane] | bit) << 1;
+                uint64_t rd = (lanes.rd[lane] | (bit << 32)) >> 1;
+                lanes.cols[lane] = cols;
+                lanes.ld[lane] = ld;
+                lanes.rd[lane] = rd;
+                lanes.avail[lane] = ~(cols | ld | (rd >> 32)) & full;
+                lanes.depth[lane] = depth + 1;
+
+                if (cols == full)
+                    solutions |= 1ULL << lane;
+            }
+            else
+            {
+                lanes.depth[lane] = --depth;
+                if (depth < 0)
+                {
+                    finished |= 1ULL << lane;
+                    continue;
+                }
+
+                uint64_t entry = stacks[depth * width + lane];
+                uint64_t bit = entry >> 32;
+                lanes.cols[lane] ^= bit;
+                lanes.ld[lane] = (lanes.ld[lane] >> 1) ^ bit;
+                lanes.rd[lane] = (lanes.rd[lane] << 1) ^ (bit << 32);
+                lanes.avail[lane] = entry & low32;
+            }
+        }
+
+        if (solutions | finished)
+            break;
+    }
+
+    return finished;
+}
+
+#ifdef BATCH_X86
+
+// 4 lanes, AVX2 has a gather for the pops but no scatter, the pushes are stored one lane at a time
+__attribute__((target("avx2"))) static uint64_t batchKernelAVX2(BatchLanes &lanes, uint64_t *stacks, uint64_t full, int budget, uint64_t &solutions)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+    const __m256i laneIndex = _mm256_set_epi64x(3, 2, 1, 0);
+    const __m256i fullVec = _mm256_set1_epi64x(static_cast<long long>(full));
+    const __m256i lowVec = _mm256_set1_epi64x(static_cast<long long>(low32));
+
+    __m256i cols = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.cols));
+    __m256i ld = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.ld));
+    __m256i rd = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.rd));
+    __m256i avail = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.avail));
+    __m256i depth = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.depth));
+
+    uint64_t finished = 0;
+    solutions = 0;
+
+    for (int step = 0; step < budget; step++)
+    {
+        __m256i active = _mm256_cmpgt_epi64(depth, allOnes);
+        __m256i empty = _mm256_cmpeq_epi64(avail, zero);
+        __m256i push = _mm256_andnot_si256(empty, active);
+        __m256i pop = _mm256_and_si256(empty, active);
+
+        // push side
+        __m256i bit = _mm256_and_si256(avail, _mm256_sub_epi64(zero, avail));
+        __m256i entry = _mm256_or_si256(_mm256_slli_epi64(bit, 32), _mm256_xor_si256(avail, bit));
+        __m256i index = _mm256_add_epi64(_mm256_slli_epi64(depth, 2), laneIndex);
+
+        // every lane stores, a lane that isn't pushing only writes the slot at its own depth, which nobody reads
+        alignas(32) uint64_t entries[4];
+        alignas(32) int64_t indices[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(entries), entry);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(indices), index);
+        stacks[indices[0]] = entries[0];
+        stacks[indices[1]] = entries[1];
+        stacks[indices[2]] = entries[2];
+        stacks[indices[3]] = entries[3];
+
+        __m256i pushCols = _mm256_or_si256(cols, bit);
+        __m256i pushLd = _mm256_slli_epi64(_mm256_or_si256(ld, bit), 1);
+        __m256i pushRd = _mm256_srli_epi64(_mm256_or_si256(rd, _mm256_slli_epi64(bit, 32)), 1);
+        __m256i pushAvail = _mm256_andnot_si256(_mm256_or_si256(pushCols, _mm256_or_si256(pushLd, _mm256_srli_epi64(pushRd, 32))), fullVec);
+
+        // pop side
+        __m256i popDepth = _mm256_sub_epi64(depth, one);
+        __m256i done = _mm256_and_si256(pop, _mm256_cmpgt_epi64(zero, popDepth));
+        __m256i popLive = _mm256_andnot_si256(done, pop);
+        __m256i popIndex = _mm256_add_epi64(_mm256_slli_epi64(popDepth, 2), laneIndex);
+        __m256i popEntry = _mm256_mask_i64gather_epi64(zero, reinterpret_cast<const long long *>(stacks), popIndex, popLive, 8);
+        __m256i popBit = _mm256_srli_epi64(popEntry, 32);
+
+        __m256i popCols = _mm256_xor_si256(cols, popBit);
+        __m256i popLd = _mm256_xor_si256(_mm256_srli_epi64(ld, 1), popBit);
+        __m256i popRd = _mm256_xor_si256(_mm256_slli_epi64(rd, 1), _mm256_slli_epi64(popBit, 32));
+        __m256i popAvail = _mm256_and_si256(popEntry, lowVec);
+
+        cols = _mm256_blendv_epi8(_mm256_blendv_epi8(cols, pushCols, push), popCols, popLive);
+        ld = _mm256_blendv_epi8(_mm256_blendv_epi8(ld, pushLd, push), popLd, popLive);
+        rd = _mm256_blendv_epi8(_mm256_blendv_epi8(rd, pushRd, push), popRd, popLive);
+        avail = _mm256_blendv_epi8(_mm256_blendv_epi8(avail, pushAvail, push), popAvail, popLive);
+        depth = _mm256_sub_epi64(_mm256_add_epi64(depth, _mm256_and_si256(push, one)), _mm256_and_si256(pop, one));
+
+        __m256i found = _mm256_and_si256(push, _mm256_cmpeq_epi64(pushCols, fullVec));
+        solutions = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(found)));
+        finished = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(done)));
+        if (solutions | finished)
+            break;
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.cols), cols);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.ld), ld);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.rd), rd);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.avail), avail);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.depth), depth);
+    return finished;
+}
+
+// 8 lanes, pushes scatter and pops gather, everything else is masked moves
+__attribute__((target("avx512f"))) static uint64_t batchKernelAVX512(BatchLanes &lanes, uint64_t *stacks, uint64_t full, int budget, uint64_t &solutions)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i laneIndex = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i fullVec = _mm512_set1_epi64(static_cast<long long>(full));
+    const __m512i lowVec = _mm512_set1_epi64(static_cast<long long>(low32));
+
+    __m512i cols = _mm512_loadu_si512(lanes.cols);
+    __m512i ld = _mm512_loadu_si512(lanes.ld);
+    __m512i rd = _mm512_loadu_si512(lanes.rd);
+    __m512i avail = _mm512_loadu_si512(lanes.avail);
+    __m512i depth = _mm512_loadu_si512(lanes.depth);
+
+    __mmask8 finished = 0;
+    __mmask8 found = 0;
+
+    for (int step = 0; step < budget; step++)
+    {
+        __mmask8 active = _mm512_cmpge_epi64_mask(depth, zero);
+        __mmask8 push = _mm512_mask_cmpneq_epi64_mask(active, avail, zero);
+        __mmask8 pop = active & ~push;
+
+        // push side
+        __m512i bit = _mm512_and_si512(avail, _mm512_sub_epi64(zero, avail));
+        __m512i entry = _mm512_or_si512(_mm512_slli_epi64(bit, 32), _mm512_xor_si512(avail, bit));
+        __m512i index = _mm512_add_epi64(_mm512_slli_epi64(depth, 3), laneIndex);
+        _mm512_mask_i64scatter_epi64(stacks, push, index, entry, 8);
+
+        __m512i pushCols = _mm512_or_si512(cols, bit);
+        __m512i pushLd = _mm512_slli_epi64(_mm512_or_si512(ld, bit), 1);
+        __m512i pushRd = _mm512_srli_epi64(_mm512_or_si512(rd, _mm512_slli_epi64(bit, 32)), 1);
+        __m512i pushAvail = _mm512_andnot_si512(_mm512_or_si512(pushCols, _mm512_or_si512(pushLd, _mm512_srli_epi64(pushRd, 32))), fullVec);
+
+        // pop side
+        __m512i popDepth = _mm512_sub_epi64(depth, one);
+        finished = _mm512_mask_cmplt_epi64_mask(pop, popDepth, zero);
+        __mmask8 popLive = pop & ~finished;
+        __m512i popIndex = _mm512_add_epi64(_mm512_slli_epi64(popDepth, 3), laneIndex);
+        __m512i popEntry = _mm512_mask_i64gather_epi64(zero, popLive, popIndex, stacks, 8);
+        __m512i popBit = _mm512_srli_epi64(popEntry, 32);
+
+        cols = _mm512_mask_mov_epi64(_mm512_mask_mov_epi64(cols, push, pushCols), popLive, _mm512_xor_si512(cols, popBit));
+        ld = _mm512_mask_mov_epi64(_mm512_mask_mov_epi64(ld, push, pushLd), popLive, _mm512_xor_si512(_mm512_srli_epi64(ld, 1), popBit));
+        rd = _mm512_mask_mov_epi64(_mm512_mask_mov_epi64(rd, push, pushRd), popLive, _mm512_xor_si512(_mm512_slli_epi64(rd, 1), _mm512_slli_epi64(popBit, 32)));
+        avail = _mm512_mask_mov_epi64(_mm512_mask_mov_epi64(avail, push, pushAvail), popLive, _mm512_and_si512(popEntry, lowVec));
+        depth = _mm512_mask_sub_epi64(_mm512_mask_add_epi64(depth, push, depth, one), pop, depth, one);
+
+        found = _mm512_mask_cmpeq_epi64_mask(push, pushCols, fullVec);
+        if (found | finished)
+            break;
+    }
+
+    _mm512_storeu_si512(lanes.cols, cols);
+    _mm512_storeu_si512(lanes.ld, ld);
+    _mm512_storeu_si512(lanes.rd, rd);
+    _mm512_storeu_si512(lanes.avail, avail);
+    _mm512_storeu_si512(lanes.depth, depth);
+    solutions = found;
+    return finished;
+}
+
+#endif
+
+struct BatchKernel
+{
+    BatchKernelFn run;
+    int width;
+    const char *name;
+};
+
+static BatchKernel selectKernel()
+{
+#ifdef BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {batchKernelAVX512, 8, "avx512"};
+    if (__builtin_cpu_supports("avx2"))
+        return {batchKernelAVX2, 4, "avx2"};
+#endif
+    return {batchKernelScalar, 4, "scalar"};
+}
+
+static const BatchKernel kernel = selectKernel();
+
+// steps between two looks at the work pool
+static constexpr int stepBudget = 256;
+
+int BatchBitsSolver::width()
+{
+    return kernel.width;
+}
+
+const char *BatchBitsSolver::kernelName()
+{
+    return kernel.name;
+}
+
+// ---- solver ----
+
+BatchBitsSolver::BatchBitsSolver(int boardSize, const Solution &initial, WorkPool *wp, const SolverOptions &opts)
+    : n(boardSize), initialState(initial), recorder(opts), workPool(wp), options(opts)
+{
+    // a lane never goes deeper than n frames, plus a scratch row in front for empty lanes, see the kernels
+    stacks.resize(static_cast<size_t>(n + 2) * BatchLanes::maxWidth);
+    board.resize(n);
+}
+
+void BatchBitsSolver::reset(const Solution &initial)
+{
+    initialState = initial;
+}
+
+// breadth first expansion of the pending prefixes, a row at a time, until there's enough to keep the lanes busy
+// stops a couple of rows short of the bottom, anything deeper is better left to the lanes
+void BatchBitsSolver::split()
+{
+    const uint64_t full = (1ULL << n) - 1;
+    const size_t target = static_cast<size_t>(4 * kernel.width);
+
+    while (!pending.empty() && pending.size() < target && pending[0].row < n - 2)
+    {
+        nextLevel.clear();
+        nextLevelBoards.clear();
+
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            const PendingSeed &seed = pending[i];
+            uint64_t avail = ~(seed.cols | seed.ld | (seed.rd >> 32)) & full;
+            if (seed.row == 0)
+                avail &= firstRowMask(n, options.symmetry);
+            else if (options.symmetry == SymmetryMode::Full)
+                avail &= canonicalRowMask<uint64_t>(n, pendingBoards[i * n], seed.row);
+
+            while (avail)
+            {
+                uint64_t bit = avail & -avail;
+                avail ^= bit;
+
+                nextLevel.push_back({seed.row + 1, seed.cols | bit, (seed.ld | bit) << 1, (seed.rd | (bit << 32)) >> 1});
+                nextLevelBoards.insert(nextLevelBoards.end(), pendingBoards.begin() + i * n, pendingBoards.begin() + (i + 1) * n);
+                nextLevelBoards[nextLevelBoards.size() - n + seed.row] = __builtin_ctzll(bit);
+            }
+        }
+
+        pending.swap(nextLevel);
+        pendingBoards.swap(nextLevelBoards);
+    }
+}
+
+// puts the next pending prefix on a lane, false if there's none left
+bool BatchBitsSolver::fillLane(int lane, size_t &nextSeed)
+{
+    if (nextSeed >= pending.size())
+        return false;
+
+    const uint64_t full = (1ULL << n) - 1;
+    const PendingSeed &seed = pending[nextSeed];
+    uint64_t avail = ~(seed.cols | seed.ld | (seed.rd >> 32)) & full;
+    if (seed.row == 0)
+        avail &= firstRowMask(n, options.symmetry);
+    else if (options.symmetry == SymmetryMode::Full)
+        avail &= canonicalRowMask<uint64_t>(n, pendingBoards[nextSeed * n], seed.row); // the lanes' deeper rows only get the leaf check
+
+    lanes.cols[lane] = seed.cols;
+    lanes.ld[lane] = seed.ld;
+    lanes.rd[lane] = seed.rd;
+    lanes.avail[lane] = avail;
+    lanes.depth[lane] = 0;
+    laneSeed[lane] = static_cast<int>(nextSeed++);
+    return true;
+}
+
+// a lane is sitting on a full board, plain counts just go up, anything else needs the board itself
+void BatchBitsSolver::laneSolution(int lane)
+{
+    if (!recorder.needsBoard())
+    {
+        recorder.recordPlain();
+        return;
+    }
+
+    // prefix from the seed, the rest is the column each frame on the lane's stack took
+    const PendingSeed &seed = pending[laneSeed[lane]];
+    std::copy(pendingBoards.begin() + static_cast<size_t>(laneSeed[lane]) * n, pendingBoards.begin() + static_cast<size_t>(laneSeed[lane] + 1) * n, board.begin());
+    for (int64_t d = 0; d < lanes.depth[lane]; d++)
+    {
+        board[seed.row + d] = __builtin_ctzll(stacks[BatchLanes::maxWidth + d * kernel.width + lane] >> 32);
+    }
+    recorder.record(board);
+}
+
+void BatchBitsSolver::solve()
+{
+    // rebuild the masks from the assigned prefix, seeds and donations are always a prefix
+    PendingSeed root = {0, 0, 0, 0};
+    while (root.row < n && initialState[root.row] != -1)
+    {
+        uint64_t bit = 1ULL << initialState[root.row];
+        root.cols |= bit;
+        root.ld = (root.ld | bit) << 1;
+        root.rd = (root.rd | (bit << 32)) >> 1;
+        root.row++;
+    }
+
+    if (root.row == n)
+    {
+        recorder.record(initialState);
+        recorder.flush();
+        return;
+    }
+
+    pending.assign(1, root);
+    pendingBoards.assign(initialState.begin(), initialState.end());
+    split();
+
+    size_t nextSeed = 0;
+    int busy = 0;
+    for (int lane = 0; lane < kernel.width; lane++)
+    {
+        lanes.depth[lane] = -1;
+        lanes.avail[lane] = 0;
+        if (fillLane(lane, nextSeed))
+            busy++;
+    }
+
+    while (busy > 0)
+    {
+        // once per kernel call, stepBudget steps per lane apart
+        if (options.limit && options.limit->stopRequested())
+            break;
+
+        // hand over the prefixes from the back, they're the last ones the lanes would get to
+        if (workPool && nextSeed < pending.size() && workPool->wantsWork())
+        {
+            workPool->push(Solution(pendingBoards.end() - n, pendingBoards.end()));
+            pending.pop_back();
+            pendingBoards.resize(pendingBoards.size() - n);
+        }
+
+        uint64_t solutions;
+        uint64_t finished = kernel.run(lanes, stacks.data() + BatchLanes::maxWidth, (1ULL << n) - 1, stepBudget, solutions);
+
+        while (solutions)
+        {
+            int lane = __builtin_ctzll(solutions);
+            solutions &= solutions - 1;
+            laneSolution(lane);
+        }
+
+        while (finished)
+        {
+            int lane = __builtin_ctzll(finished);
+            finished &= finished - 1;
+            if (!fillLane(lane, nextSeed))
+                busy--;
+        }
+    }
+
+    recorder.flush();
+}
+
+uint64_t BatchBitsSolver::getSolutionCount() const
+{
+    return recorder.getSolutionCount();
+}
+
+uint64_t BatchBitsSolver::getUniqueCount() const
+{
+    return recorder.getUniqueCount();
+}
+
+std::chrono::high_resolution_clock::time_point BatchBitsSolver::getFirstSolutionTime() const
+{
+    return recorder.getFirstSolutionTime();
+}
@@ -0,0 +1,74 @@
+#ifndef BATCHBITSSOLVER_H
+#define BATCHBITSSOLVER_H
+
+#include "Solver.h"
+#include "WorkPool.h"
+#include "SolutionRecorder.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// the search state of every lane, one slot per lane (struct of arrays, so a vector load picks up all lanes)
+// ld isn't masked to the board and rd is kept 32 bits up, so neither loses bits on the way down
+// and a parent's masks can be rebuilt from the child's and the column it took, the stacks only hold one word per frame
+struct alignas(64) BatchLanes
+{
+    static constexpr int maxWidth = 8;
+
+    uint64_t cols[maxWidth];  // columns taken
+    uint64_t ld[maxWidth];    // left diagonals hitting the current row, grows up to bit 2n-1
+    uint64_t rd[maxWidth];    // right diagonals hitting the current row, shifted up by 32
+    uint64_t avail[maxWidth]; // columns still left to try in the current row
+    int64_t depth[maxWidth];  // frames pushed since the lane's seed, -1 = lane is empty
+};
+
+// BT-BITS, but width subtrees at a time in lockstep, one per SIMD lane (8 with AVX-512, 4 with AVX2 or the scalar fallback)
+// every seed gets split into a few dozen deeper prefixes, lanes take those and get refilled as soon as one runs dry,
+// the prefixes nobody has taken yet are also what gets donated to idle workers
+// meant for count only runs, found solutions still come out (rebuilt from the lane's stack) but that's the slow path
+// only covers n <= 32 and doesn't seed, spawnSolver hands those cases to BTBitsSolver
+class BatchBitsSolver : public Solver
+{
+private:
+    // a prefix waiting for a lane, its board lives in pendingBoards[index * n]
+    struct PendingSeed
+    {
+        int row; // first unassigned row
+        uint64_t cols, ld, rd;
+    };
+
+    int n;
+    Solution initialState;
+    SolutionRecorder recorder;
+    WorkPool *workPool;
+    SolverOptions options;
+
+    // search state, kept between seeds so reset() + solve() reuses the allocations
+    BatchLanes lanes;
+    std::vector<uint64_t> stacks; // stacks[maxWidth + depth * width + lane] = (column taken << 32) | columns left
+    std::vector<PendingSeed> pending;
+    std::vector<int> pendingBoards;
+    std::vector<PendingSeed> nextLevel;
+    std::vector<int> nextLevelBoards;
+    int laneSeed[BatchLanes::maxWidth]; // which pending seed a lane is working on
+    Solution board;
+
+    void split();
+    bool fillLane(int lane, size_t &nextSeed);
+    void laneSolution(int lane);
+
+public:
+    BatchBitsSolver(int boardSize, const Solution &initial, WorkPool *wp = nullptr, const SolverOptions &opts = SolverOptions());
+    void solve() override;
+    void reset(const Solution &initial) override;
+    uint64_t getSolutionCount() const override;
+    uint64_t getUniqueCount() const override;
+    std::chrono::high_resolution_clock::time_point getFirstSolutionTime() const override;
+
+    static constexpr int maxBoardSize = 32;
+    // lanes per batch and the kernel running them, picked once at startup
+    static int width();
+    static const char *kernelName();
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef BOARDSIZE_H
+#define BOARDSIZE_H
+
+#include "Solver.h"
+#include "AttackTable.h"
+#include "WorkPool.h"
+#include "DomainBits.h"
+#include <array>
+#include <memory>
+
+// board sizes for the domain based solvers, the solvers are templates on one of these
+// BoardSize<N> for N in [minFixedSize, maxFixedSize]: the board size is a constant,
+// boards and domains are std::arrays, the attack masks are a constexpr table and every loop bound is known,
+// so the compiler can unroll forward checking and revise for the sizes we actually run
+// BoardSize<0> is the runtime sized version, it covers every other size up to 64
+// WideBoardSize<Word> goes past 64 columns, domains are 128 bit or multiword, see DomainBits.h
+constexpr int minFixedSize = 4;
+constexpr int maxFixedSize = 32;
+constexpr int maxBoardSize = 1024;
+
+// same layout and interface as AttackTable, but generated at compile time
+template <int N>
+struct FixedAttackTable
+{
+    static constexpr std::array<uint64_t, N * N> build()
+    {
+        std::array<uint64_t, N * N> masks{};
+
+        // distance 0 is the queen's own row, stays 0
+        for (int distance = 1; distance < N; distance++)
+        {
+            for (int col = 0; col < N; col++)
+            {
+                uint64_t mask = 1ULL << col;
+                if (col + distance < N)
+                    mask |= 1ULL << (col + distance);
+                if (col - distance >= 0)
+                    mask |= 1ULL << (col - distance);
+                masks[distance * N + col] = mask;
+            }
+        }
+        return masks;
+    }
+
+    alignas(64) static constexpr std::array<uint64_t, N * N> masks = build();
+
+    uint64_t mask(int r1, int r2, int col) const
+    {
+        int distance = r1 > r2 ? r1 - r2 : r2 - r1;
+        return masks[distance * N + col];
+    }
+
+    uint64_t atDistance(int distance, int col) const
+    {
+        return masks[distance * N + col];
+    }
+};
+
+// everything a solver needs to know about its board size, solvers inherit it privately
+template <int N>
+struct BoardSize
+{
+    using Word = uint64_t;
+    using Board = std::array<int, N>;
+    using Domains = std::array<uint64_t, N>; // domains[i] = bitmask of available columns for row i
+
+    static constexpr int n = N;
+    FixedAttackTable<N> attacks;
+    Solution scratch; // boards only become a Solution when they leave the solver
+
+    explicit BoardSize(int) : scratch(N) {}
+
+    // arrays come sized already
+    void allocate(Board &, Domains &) {}
+    void allocate(Domains &) {}
+
+    const Solution &asSolution(const Board &board)
+    {
+        std::copy(board.begin(), board.end(), scratch.begin());
+        return scratch;
+    }
+};
+
+template <>
+struct BoardSize<0>
+{
+    using Word = uint64_t;
+    using Board = Solution;
+    using Domains = std::vector<uint64_t>;
+
+    int n;
+    const AttackTable &attacks; // shared read only table, see AttackTable.h
+
+    explicit BoardSize(int boardSize) : n(boardSize), attacks(AttackTable::get(boardSize)) {}
+
+    void allocate(Board &board, Domains &domains)
+    {
+        board.assign(n, -1);
+        allocate(domains);
+    }
+
+    void allocate(Domains &domains)
+    {
+        domains.assign(n, 0);
+    }
+
+    const Solution &asSolution(const Board &board)
+    {
+        return board;
+    }
+};
+
+// attack masks for the wide sizes, an n^2 table of multiword masks would be megabytes,
+// but a mask is at most 3 columns so it's cheaper to just build it
+template <class Word>
+struct ComputedAttacks
+{
+    int n;
+
+    Word mask(int r1, int r2, int col) const
+    {
+        return atDistance(r1 > r2 ? r1 - r2 : r2 - r1, col);
+    }
+
+    Word atDistance(int distance, int col) const
+    {
+        Word mask = emptyBits<Word>();
+        if (distance == 0)
+            return mask;
+
+        setBit(mask, col);
+        if (col + distance < n)
+            setBit(mask, col + distance);
+        if (col - distance >= 0)
+            setBit(mask, col - distance);
+        return mask;
+    }
+};
+
+template <class DomainWord>
+struct WideBoardSize
+{
+    using Word = DomainWord;
+    using Board = Solution;
+    using Domains = std::vector<Word>;
+
+    int n;
+    ComputedAttacks<Word> attacks;
+
+    explicit WideBoardSize(int boardSize) : n(boardSize), attacks{boardSize} {}
+
+    void allocate(Board &board, Domains &domains)
+    {
+        board.assign(n, -1);
+        allocate(domains);
+    }
+
+    void allocate(Domains &domains)
+    {
+        domains.assign(n, emptyBits<Word>());
+    }
+
+    const Solution &asSolution(const Board &board)
+    {
+        return board;
+    }
+};
+
+// picks SolverT<BoardSize<boardSize>> if there is one, N counts down from maxFixedSize
+// past that it's SolverT<BoardSize<0>> up to 64 and the narrowest WideBoardSize that fits up to maxBoardSize,
+// nullptr for anything bigger
+// needs SolverT's member definitions, so it's only called from the solver's own .cpp
+template <template <class> class SolverT, int N = maxFixedSize>
+std::unique_ptr<Solver> makeSizedSolver(int boardSize, const Solution &initial, int maxDepth, WorkPool *wp, const SolverOptions &opts)
+{
+    if constexpr (N < minFixedSize)
+    {
+        if (boardSize <= 64)
+            return std::make_unique<SolverT<BoardSize<0>>>(boardSize, initial, maxDepth, wp, opts);
+        if (boardSize <= 128)
+            return std::make_unique<SolverT<WideBoardSize<unsigned __int128>>>(boardSize, initial, maxDepth, wp, opts);
+        if (boardSize <= 256)
+            return std::make_unique<SolverT<WideBoardSize<WideBits<4>>>>(boardSize, initial, maxDepth, wp, opts);
+        if (boardSize <= 512)
+            return std::make_unique<SolverT<WideBoardSize<WideBits<8>>>>(boardSize, initial, maxDepth, wp, opts);
+        if (boardSize <= maxBoardSize)
+            return std::make_unique<SolverT<WideBoardSize<WideBits<16>>>>(boardSize, initial, maxDepth, wp, opts);
+        return nullptr;
+    }
+    else
+    {
+        if (boardSize == N)
+            return std::make_unique<SolverT<BoardSize<N>>>(boardSize, initial, maxDepth, wp, opts);
+        return makeSizedSolver<SolverT, N - 1>(boardSize, initial, maxDepth, wp, opts);
+    }
+}
+
+#endif
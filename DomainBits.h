@@ -0,0 +1,236 @@
+#ifndef DOMAINBITS_H
+#define DOMAINBITS_H
+
+#include <cstdint>
+
+// the column sets the search engine works with, one word per row domain
+// uint64_t covers n <= 64, unsigned __int128 n <= 128 and WideBits<W> W * 64 columns
+// every word type gets the same handful of free functions below, so the policies never care which one they have
+
+// W words, word 0 holds columns 0-63, plain loops the compiler unrolls and vectorizes
+template <int W>
+struct WideBits
+{
+    uint64_t words[W];
+
+    WideBits &operator&=(const WideBits &other)
+    {
+        for (int i = 0; i < W; i++)
+            words[i] &= other.words[i];
+        return *this;
+    }
+
+    WideBits &operator|=(const WideBits &other)
+    {
+        for (int i = 0; i < W; i++)
+            words[i] |= other.words[i];
+        return *this;
+    }
+
+    friend WideBits operator&(WideBits a, const WideBits &b)
+    {
+        return a &= b;
+    }
+
+    friend WideBits operator|(WideBits a, const WideBits &b)
+    {
+        return a |= b;
+    }
+
+    friend WideBits operator~(WideBits a)
+    {
+        for (int i = 0; i < W; i++)
+            a.words[i] = ~a.words[i];
+        return a;
+    }
+
+    friend bool operator==(const WideBits &a, const WideBits &b)
+    {
+        uint64_t diff = 0;
+        for (int i = 0; i < W; i++)
+            diff |= a.words[i] ^ b.words[i];
+        return diff == 0;
+    }
+
+    friend bool operator!=(const WideBits &a, const WideBits &b)
+    {
+        return !(a == b);
+    }
+};
+
+// ---- uint64_t ----
+
+inline bool isEmpty(uint64_t x)
+{
+    return x == 0;
+}
+
+inline int lowestBit(uint64_t x)
+{
+    return __builtin_ctzll(x);
+}
+
+inline int highestBit(uint64_t x)
+{
+    return 63 - __builtin_clzll(x);
+}
+
+inline int bitCount(uint64_t x)
+{
+    return __builtin_popcountll(x);
+}
+
+inline void clearLowest(uint64_t &x)
+{
+    x &= x - 1;
+}
+
+inline void setBit(uint64_t &x, int bit)
+{
+    x |= 1ULL << bit;
+}
+
+inline void clearBit(uint64_t &x, int bit)
+{
+    x &= ~(1ULL << bit);
+}
+
+// ---- unsigned __int128 ----
+
+inline bool isEmpty(unsigned __int128 x)
+{
+    return x == 0;
+}
+
+inline int lowestBit(unsigned __int128 x)
+{
+    uint64_t low = static_cast<uint64_t>(x);
+    return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(x >> 64));
+}
+
+inline int highestBit(unsigned __int128 x)
+{
+    uint64_t high = static_cast<uint64_t>(x >> 64);
+    return high ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll(static_cast<uint64_t>(x));
+}
+
+inline int bitCount(unsigned __int128 x)
+{
+    return __builtin_popcountll(static_cast<uint64_t>(x)) + __builtin_popcountll(static_cast<uint64_t>(x >> 64));
+}
+
+inline void clearLowest(unsigned __int128 &x)
+{
+    x &= x - 1;
+}
+
+inline void setBit(unsigned __int128 &x, int bit)
+{
+    x |= static_cast<unsigned __int128>(1) << bit;
+}
+
+inline void clearBit(unsigned __int128 &x, int bit)
+{
+    x &= ~(static_cast<unsigned __int128>(1) << bit);
+}
+
+// ---- WideBits ----
+
+template <int W>
+bool isEmpty(const WideBits<W> &x)
+{
+    uint64_t any = 0;
+    for (int i = 0; i < W; i++)
+        any |= x.words[i];
+    return any == 0;
+}
+
+template <int W>
+int lowestBit(const WideBits<W> &x)
+{
+    for (int i = 0; i < W; i++)
+    {
+        if (x.words[i])
+            return i * 64 + __builtin_ctzll(x.words[i]);
+    }
+    return -1;
+}
+
+template <int W>
+int highestBit(const WideBits<W> &x)
+{
+    for (int i = W - 1; i >= 0; i--)
+    {
+        if (x.words[i])
+            return i * 64 + 63 - __builtin_clzll(x.words[i]);
+    }
+    return -1;
+}
+
+template <int W>
+int bitCount(const WideBits<W> &x)
+{
+    int count = 0;
+    for (int i = 0; i < W; i++)
+        count += __builtin_popcountll(x.words[i]);
+    return count;
+}
+
+template <int W>
+void clearLowest(WideBits<W> &x)
+{
+    for (int i = 0; i < W; i++)
+    {
+        if (x.words[i])
+        {
+            x.words[i] &= x.words[i] - 1;
+            return;
+        }
+    }
+}
+
+template <int W>
+void setBit(WideBits<W> &x, int bit)
+{
+    x.words[bit >> 6] |= 1ULL << (bit & 63);
+}
+
+template <int W>
+void clearBit(WideBits<W> &x, int bit)
+{
+    x.words[bit >> 6] &= ~(1ULL << (bit & 63));
+}
+
+// ---- any word ----
+
+template <class Word>
+Word emptyBits()
+{
+    return Word{};
+}
+
+template <class Word>
+Word singleBit(int bit)
+{
+    Word x{};
+    setBit(x, bit);
+    return x;
+}
+
+// columns [0, count)
+template <class Word>
+Word lowBits(int count)
+{
+    Word x{};
+    for (int bit = 0; bit < count; bit++)
+        setBit(x, bit);
+    return x;
+}
+
+template <>
+inline uint64_t lowBits<uint64_t>(int count)
+{
+    return count >= 64 ? ~0ULL : (1ULL << count) - 1;
+}
+
+#endif
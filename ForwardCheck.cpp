@@ -0,0 +1,147 @@
+#include "ForwardCheck.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FORWARDCHECK_X86 1
+#include <immintrin.h>
+#endif
+
+using ForwardCheckFn = uint64_t (*)(const uint64_t *, uint64_t *, int, uint64_t, int, int, bool &);
+
+static uint64_t forwardCheckScalar(const uint64_t *domains, uint64_t *out, int, uint64_t rows, int row, int col, bool &wipeout)
+{
+    uint64_t colBit = 1ULL << col;
+    uint64_t changed = 0;
+    bool empty = false;
+
+    while (rows)
+    {
+        int r = __builtin_ctzll(rows);
+        rows &= rows - 1;
+
+        int distance = r > row ? r - row : row - r;
+        uint64_t attacked = colBit | (colBit << distance) | (colBit >> distance);
+
+        uint64_t domain = domains[r] & ~attacked;
+        out[r] = domain;
+        if (domain != domains[r])
+            changed |= 1ULL << r;
+        empty |= (domain == 0);
+    }
+
+    wipeout = empty;
+    return changed;
+}
+
+#ifdef FORWARDCHECK_X86
+
+// 4 rows per step
+// variable shifts by more than 63 give 0, so shifting by both r - row and row - r (one of them wraps to a huge count)
+// gives the two diagonals without needing a 64 bit abs
+__attribute__((target("avx2"))) static uint64_t forwardCheckAVX2(const uint64_t *domains, uint64_t *out, int n, uint64_t rows, int row, int col, bool &wipeout)
+{
+    const __m256i colBit = _mm256_set1_epi64x(static_cast<long long>(1ULL << col));
+    const __m256i rowVec = _mm256_set1_epi64x(row);
+    const __m256i laneBits = _mm256_set_epi64x(8, 4, 2, 1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    uint64_t changed = 0;
+    uint64_t empty = 0;
+
+    for (int base = 0; base < n; base += 4)
+    {
+        uint64_t laneRows = (rows >> base) & 0xF;
+        if (laneRows == 0)
+            continue;
+
+        // which of the 4 lanes are in rows, as a load/store mask
+        __m256i laneMask = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(laneRows)), laneBits), laneBits);
+
+        __m256i r = _mm256_add_epi64(_mm256_set1_epi64x(base), _mm256_set_epi64x(3, 2, 1, 0));
+        __m256i below = _mm256_sub_epi64(r, rowVec);
+        __m256i above = _mm256_sub_epi64(rowVec, r);
+        __m256i attacked = _mm256_or_si256(colBit, _mm256_or_si256(
+            _mm256_or_si256(_mm256_sllv_epi64(colBit, below), _mm256_srlv_epi64(colBit, below)),
+            _mm256_or_si256(_mm256_sllv_epi64(colBit, above), _mm256_srlv_epi64(colBit, above))));
+
+        __m256i domain = _mm256_maskload_epi64(reinterpret_cast<const long long *>(domains + base), laneMask);
+        __m256i pruned = _mm256_andnot_si256(attacked, domain);
+        _mm256_maskstore_epi64(reinterpret_cast<long long *>(out + base), laneMask, pruned);
+
+        uint64_t same = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(pruned, domain))));
+        uint64_t isEmpty = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(pruned, zero))));
+        changed |= (~same & laneRows) << base;
+        empty |= isEmpty & laneRows;
+    }
+
+    wipeout = empty != 0;
+    return changed;
+}
+
+// 8 rows per step, masks come straight out of the compares
+__attribute__((target("avx512f"))) static uint64_t forwardCheckAVX512(const uint64_t *domains, uint64_t *out, int n, uint64_t rows, int row, int col, bool &wipeout)
+{
+    const __m512i colBit = _mm512_set1_epi64(static_cast<long long>(1ULL << col));
+    const __m512i rowVec = _mm512_set1_epi64(row);
+    const __m512i lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+
+    uint64_t changed = 0;
+    __mmask8 empty = 0;
+
+    for (int base = 0; base < n; base += 8)
+    {
+        __mmask8 laneRows = static_cast<__mmask8>(rows >> base);
+        if (laneRows == 0)
+            continue;
+
+        __m512i r = _mm512_add_epi64(_mm512_set1_epi64(base), lanes);
+        __m512i below = _mm512_sub_epi64(r, rowVec);
+        __m512i above = _mm512_sub_epi64(rowVec, r);
+        __m512i attacked = _mm512_or_si512(colBit, _mm512_or_si512(
+            _mm512_or_si512(_mm512_sllv_epi64(colBit, below), _mm512_srlv_epi64(colBit, below)),
+            _mm512_or_si512(_mm512_sllv_epi64(colBit, above), _mm512_srlv_epi64(colBit, above))));
+
+        __m512i domain = _mm512_maskz_loadu_epi64(laneRows, domains + base);
+        __m512i pruned = _mm512_andnot_si512(attacked, domain);
+        _mm512_mask_storeu_epi64(out + base, laneRows, pruned);
+
+        changed |= static_cast<uint64_t>(_mm512_mask_cmpneq_epi64_mask(laneRows, pruned, domain)) << base;
+        empty |= _mm512_mask_cmpeq_epi64_mask(laneRows, pruned, _mm512_setzero_si512());
+    }
+
+    wipeout = empty != 0;
+    return changed;
+}
+
+#endif
+
+static ForwardCheckFn selectKernel(const char *&name)
+{
+#ifdef FORWARDCHECK_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        name = "avx512";
+        return forwardCheckAVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        name = "avx2";
+        return forwardCheckAVX2;
+    }
+#endif
+    name = "scalar";
+    return forwardCheckScalar;
+}
+
+static const char *kernelName = "";
+static const ForwardCheckFn kernel = selectKernel(kernelName);
+
+uint64_t forwardCheck(const uint64_t *domains, uint64_t *out, int n, uint64_t rows, int row, int col, bool &wipeout)
+{
+    return kernel(domains, out, n, rows, row, col, wipeout);
+}
+
+const char *forwardCheckKernelName()
+{
+    return kernelName;
+}
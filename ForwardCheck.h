@@ -0,0 +1,18 @@
+#ifndef FORWARDCHECK_H
+#define FORWARDCHECK_H
+
+#include <cstdint>
+
+// forward checking kernel shared by every FC / AC3 engine, static and MRV ordering alike
+// for a queen at (row, col) it computes out[r] = domains[r] & ~attacked(r) for every r in rows, in one pass,
+// the attack masks are built in registers (col bit, shifted left and right by |r - row|), no table lookups
+// returns the rows whose domain changed, wipeout is set if any of them ended up empty
+// nothing in domains is touched, so on a wipeout there's nothing to undo
+// AVX-512 or AVX2 is picked at runtime when the cpu has it, otherwise it's the scalar loop
+// rows must only contain rows < n, out needs room for n words
+uint64_t forwardCheck(const uint64_t *domains, uint64_t *out, int n, uint64_t rows, int row, int col, bool &wipeout);
+
+// "avx512", "avx2" or "scalar", whatever forwardCheck ended up using
+const char *forwardCheckKernelName();
+
+#endif
@@ -0,0 +1,274 @@
+#include "PackedSolutionFile.h"
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const char packedMagic[8] = {'N', 'Q', 'S', 'O', 'L', 'B', 'I', 'N'};
+static const uint32_t packedVersion = 1;
+
+int packedBitsPerColumn(int n)
+{
+    int bits = 1;
+    while ((1 << bits) < n)
+        bits++;
+    return bits;
+}
+
+int packedRecordBytes(int n)
+{
+    return (n * packedBitsPerColumn(n) + 7) / 8;
+}
+
+void packSolution(const Solution &sol, int bitsPerColumn, uint8_t *out)
+{
+    int n = static_cast<int>(sol.size());
+    std::memset(out, 0, (n * bitsPerColumn + 7) / 8);
+
+    int bit = 0;
+    for (int col : sol)
+    {
+        uint32_t value = static_cast<uint32_t>(col);
+        int done = 0;
+        while (done < bitsPerColumn)
+        {
+            int offset = bit & 7;
+            int take = std::min(8 - offset, bitsPerColumn - done);
+            out[bit >> 3] |= static_cast<uint8_t>(((value >> done) & ((1u << take) - 1)) << offset);
+            bit += take;
+            done += take;
+        }
+    }
+}
+
+void unpackSolution(const uint8_t *in, int n, int bitsPerColumn, Solution &sol)
+{
+    sol.resize(n);
+
+    int bit = 0;
+    for (int row = 0; row < n; row++)
+    {
+        uint32_t value = 0;
+        int done = 0;
+        while (done < bitsPerColumn)
+        {
+            int offset = bit & 7;
+            int take = std::min(8 - offset, bitsPerColumn - done);
+            value |= ((static_cast<uint32_t>(in[bit >> 3]) >> offset) & ((1u << take) - 1)) << done;
+            bit += take;
+            done += take;
+        }
+        sol[row] = static_cast<int>(value);
+    }
+}
+
+BinaryFileSink::BinaryFileSink(const std::string &filename, int boardSize, const std::string &solverType, SymmetryMode symmetry)
+    : reserved(0), failed(false)
+{
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, packedMagic, sizeof(packedMagic));
+    header.version = packedVersion;
+    header.boardSize = boardSize;
+    header.bitsPerColumn = packedBitsPerColumn(boardSize);
+    header.recordBytes = packedRecordBytes(boardSize);
+    header.count = 0;
+    header.symmetry = static_cast<uint32_t>(symmetry);
+    std::strncpy(header.solverType, solverType.c_str(), sizeof(header.solverType) - 1);
+
+#ifdef _WIN32
+    file = std::fopen(filename.c_str(), "wb");
+    failed = !file;
+#else
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    failed = fd < 0;
+#endif
+}
+
+BinaryFileSink::~BinaryFileSink()
+{
+    close();
+}
+
+void BinaryFileSink::consume(const std::vector<Solution> &batch)
+{
+    // the file is incomplete already, nothing written after this can make it valid
+    if (failed)
+        return;
+
+    std::vector<uint8_t> records(batch.size() * header.recordBytes);
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        packSolution(batch[i], header.bitsPerColumn, records.data() + i * header.recordBytes);
+    }
+
+    // slot range for this batch, the file layout doesn't care which thread got which slots
+    uint64_t first = reserved.fetch_add(batch.size());
+    uint64_t offset = sizeof(PackedSolutionHeader) + first * header.recordBytes;
+
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(mutex);
+    if (failed)
+        return;
+    if (_fseeki64(file, offset, SEEK_SET) != 0 || std::fwrite(records.data(), 1, records.size(), file) != records.size())
+        failed = true;
+#else
+    // pwrite can come back short, keep going until the whole batch is down
+    size_t written = 0;
+    while (written < records.size())
+    {
+        ssize_t n = pwrite(fd, records.data() + written, records.size() - written, offset + written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            failed = true;
+            return;
+        }
+        written += n;
+    }
+#endif
+}
+
+void BinaryFileSink::close()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    header.count = reserved.load();
+
+#ifdef _WIN32
+    if (!file)
+        return;
+    if (!failed && (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file) != 1))
+        failed = true;
+    if (std::fclose(file) != 0)
+        failed = true;
+    file = nullptr;
+#else
+    if (fd < 0)
+        return;
+    if (!failed && pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+        failed = true;
+    if (::close(fd) != 0)
+        failed = true;
+    fd = -1;
+#endif
+}
+
+bool BinaryFileSink::good() const
+{
+    return !failed;
+}
+
+PackedSolutionReader::PackedSolutionReader()
+    : data(nullptr), length(0), header(nullptr) {}
+
+PackedSolutionReader::~PackedSolutionReader()
+{
+    close();
+}
+
+bool PackedSolutionReader::open(const std::string &filename)
+{
+    close();
+
+#ifdef _WIN32
+    std::ifstream in(filename, std::ios::binary);
+    if (!in)
+        return false;
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    length = buffer.size();
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(PackedSolutionHeader)))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping stays valid without the fd
+    if (mapped == MAP_FAILED)
+        return false;
+
+    data = static_cast<const uint8_t *>(mapped);
+    length = st.st_size;
+#endif
+
+    if (length < sizeof(PackedSolutionHeader))
+    {
+        close();
+        return false;
+    }
+
+    header = reinterpret_cast<const PackedSolutionHeader *>(data);
+    bool valid = std::memcmp(header->magic, packedMagic, sizeof(packedMagic)) == 0 &&
+                 header->version == packedVersion &&
+                 header->recordBytes == static_cast<uint32_t>(packedRecordBytes(header->boardSize)) &&
+                 length >= sizeof(PackedSolutionHeader) + header->count * header->recordBytes;
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void PackedSolutionReader::close()
+{
+#ifdef _WIN32
+    buffer.clear();
+#else
+    if (data)
+        munmap(const_cast<uint8_t *>(data), length);
+#endif
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+}
+
+uint64_t PackedSolutionReader::size() const
+{
+    return header ? header->count : 0;
+}
+
+int PackedSolutionReader::getBoardSize() const
+{
+    return header ? static_cast<int>(header->boardSize) : 0;
+}
+
+SymmetryMode PackedSolutionReader::getSymmetry() const
+{
+    return header ? static_cast<SymmetryMode>(header->symmetry) : SymmetryMode::None;
+}
+
+std::string PackedSolutionReader::getSolverType() const
+{
+    if (!header)
+        return "";
+    return std::string(header->solverType, strnlen(header->solverType, sizeof(header->solverType)));
+}
+
+void PackedSolutionReader::get(uint64_t i, Solution &sol) const
+{
+    const uint8_t *record = data + sizeof(PackedSolutionHeader) + i * header->recordBytes;
+    unpackSolution(record, header->boardSize, header->bitsPerColumn, sol);
+}
+
+Solution PackedSolutionReader::get(uint64_t i) const
+{
+    Solution sol;
+    get(i, sol);
+    return sol;
+}
@@ -0,0 +1,89 @@
+#ifndef PACKEDSOLUTIONFILE_H
+#define PACKEDSOLUTIONFILE_H
+
+#include "SolutionSink.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <atomic>
+
+// fixed width binary solution file, alternative to the text output
+// [64 byte header][record 0][record 1]...
+// every record is one solution, n columns of bitsPerColumn = ceil(log2 n) bits each, packed LSB first,
+// padded to whole bytes so solution i starts at headerSize + i * recordBytes
+struct PackedSolutionHeader
+{
+    char magic[8];         // "NQSOLBIN"
+    uint32_t version;
+    uint32_t boardSize;
+    uint32_t bitsPerColumn;
+    uint32_t recordBytes;
+    uint64_t count;
+    uint32_t symmetry;     // SymmetryMode the run used, records always hold the expanded set
+    uint32_t reserved;
+    char solverType[24];
+};
+
+static_assert(sizeof(PackedSolutionHeader) == 64, "header layout is part of the file format");
+
+int packedBitsPerColumn(int n);
+int packedRecordBytes(int n);
+void packSolution(const Solution &sol, int bitsPerColumn, uint8_t *out);
+void unpackSolution(const uint8_t *in, int n, int bitsPerColumn, Solution &sol);
+
+// streams records to disk as batches come in, the count gets patched into the header on close()
+// records are fixed width, so every batch reserves its slot range with one atomic add and
+// pwrites there, worker threads never wait on each other for output
+// a failed open or write leaves a hole the count can't account for, so after one the header never gets written
+// (a zeroed header, PackedSolutionReader rejects the file) and good() turns false
+class BinaryFileSink : public SolutionSink
+{
+private:
+#ifdef _WIN32
+    FILE *file; // no pwrite, batches get written under the mutex instead
+#else
+    int fd;
+#endif
+    PackedSolutionHeader header;
+    std::atomic<uint64_t> reserved; // records handed out so far
+    std::atomic<bool> failed;       // a write didn't make it to disk
+    std::mutex mutex;
+
+public:
+    BinaryFileSink(const std::string &filename, int boardSize, const std::string &solverType, SymmetryMode symmetry);
+    ~BinaryFileSink();
+    void consume(const std::vector<Solution> &batch) override;
+    void close();
+    // false once the file couldn't be opened or a write failed, stays false after close()
+    bool good() const;
+};
+
+// mmaps a packed file, solution i is decoded straight out of the mapping, nothing gets parsed up front
+class PackedSolutionReader
+{
+private:
+    const uint8_t *data;
+    size_t length;
+    const PackedSolutionHeader *header;
+#ifdef _WIN32
+    std::vector<uint8_t> buffer; // no mmap here, just read it all in
+#endif
+
+public:
+    PackedSolutionReader();
+    ~PackedSolutionReader();
+
+    // false if the file can't be opened or isn't a packed solution file
+    bool open(const std::string &filename);
+    void close();
+
+    uint64_t size() const;
+    int getBoardSize() const;
+    SymmetryMode getSymmetry() const;
+    std::string getSolverType() const;
+
+    void get(uint64_t i, Solution &sol) const;
+    Solution get(uint64_t i) const;
+};
+
+#endif
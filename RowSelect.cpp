@@ -0,0 +1,123 @@
+#include "RowSelect.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROWSELECT_X86 1
+#include <immintrin.h>
+#endif
+
+using MinDomainRowFn = int (*)(const uint64_t *, int, uint64_t);
+
+static int minDomainRowScalar(const uint64_t *domains, int, uint64_t rows)
+{
+    int bestRow = -1;
+    int minDomainSize = 65;
+
+    while (rows)
+    {
+        int row = __builtin_ctzll(rows);
+        rows &= rows - 1;
+
+        int domainSize = __builtin_popcountll(domains[row]);
+        if (domainSize < minDomainSize)
+        {
+            minDomainSize = domainSize;
+            bestRow = row;
+        }
+    }
+
+    return bestRow;
+}
+
+#ifdef ROWSELECT_X86
+
+// same loop, but __builtin_popcountll becomes the instruction instead of a bit trick sequence
+__attribute__((target("popcnt"))) static int minDomainRowPopcnt(const uint64_t *domains, int, uint64_t rows)
+{
+    int bestRow = -1;
+    int minDomainSize = 65;
+
+    while (rows)
+    {
+        int row = __builtin_ctzll(rows);
+        rows &= rows - 1;
+
+        int domainSize = __builtin_popcountll(domains[row]);
+        if (domainSize < minDomainSize)
+        {
+            minDomainSize = domainSize;
+            bestRow = row;
+        }
+    }
+
+    return bestRow;
+}
+
+// one pass for the smallest size, a second one for the first row that has it
+// rows outside the set count as 255 so they never win
+__attribute__((target("avx512f,avx512vpopcntdq"))) static int minDomainRowAVX512(const uint64_t *domains, int n, uint64_t rows)
+{
+    const __m512i none = _mm512_set1_epi64(255);
+
+    __m512i best = none;
+    for (int base = 0; base < n; base += 8)
+    {
+        __mmask8 lanes = static_cast<__mmask8>(rows >> base);
+        if (lanes == 0)
+            continue;
+
+        __m512i sizes = _mm512_mask_popcnt_epi64(none, lanes, _mm512_maskz_loadu_epi64(lanes, domains + base));
+        best = _mm512_min_epu64(best, sizes);
+    }
+
+    uint64_t minDomainSize = _mm512_reduce_min_epu64(best);
+    if (minDomainSize == 255)
+        return -1;
+
+    const __m512i target = _mm512_set1_epi64(static_cast<long long>(minDomainSize));
+    for (int base = 0; base < n; base += 8)
+    {
+        __mmask8 lanes = static_cast<__mmask8>(rows >> base);
+        if (lanes == 0)
+            continue;
+
+        __m512i sizes = _mm512_maskz_popcnt_epi64(lanes, _mm512_maskz_loadu_epi64(lanes, domains + base));
+        __mmask8 hits = _mm512_mask_cmpeq_epi64_mask(lanes, sizes, target);
+        if (hits)
+            return base + __builtin_ctz(hits);
+    }
+    return -1;
+}
+
+#endif
+
+static MinDomainRowFn selectKernel(const char *&name)
+{
+#ifdef ROWSELECT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+    {
+        name = "avx512";
+        return minDomainRowAVX512;
+    }
+    if (__builtin_cpu_supports("popcnt"))
+    {
+        name = "popcnt";
+        return minDomainRowPopcnt;
+    }
+#endif
+    name = "scalar";
+    return minDomainRowScalar;
+}
+
+static const char *kernelName = "";
+static const MinDomainRowFn kernel = selectKernel(kernelName);
+
+int minDomainRow(const uint64_t *domains, int n, uint64_t rows)
+{
+    return kernel(domains, n, rows);
+}
+
+const char *minDomainRowKernelName()
+{
+    return kernelName;
+}
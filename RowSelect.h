@@ -0,0 +1,15 @@
+#ifndef ROWSELECT_H
+#define ROWSELECT_H
+
+#include <cstdint>
+
+// MRV's row pick for 64 bit domains: the row in rows whose domain has the fewest columns, lowest row on ties, -1 if rows is empty
+// popcount and min run 8 rows at a time with AVX-512 VPOPCNTQ, otherwise it's a loop over rows with the popcnt instruction,
+// or without it on cpus that don't have one, picked at runtime like forwardCheck
+// rows must only contain rows < n
+int minDomainRow(const uint64_t *domains, int n, uint64_t rows);
+
+// "avx512", "popcnt" or "scalar"
+const char *minDomainRowKernelName();
+
+#endif
@@ -0,0 +1,243 @@
+#include "SearchEngine.h"
+#include "Symmetry.h"
+#include "SearchLimit.h"
+#include <algorithm>
+
+template <class Size, class Propagation, class Ordering>
+SearchEngine<Size, Propagation, Ordering>::SearchEngine(int boardSize, const Solution &initial, int maxDepth, WorkPool *wp, const SolverOptions &opts)
+    : ctx(boardSize), initialState(initial), recorder(opts), maxDepth(maxDepth), workPool(wp), options(opts)
+{
+    frames.reserve(ctx.n);
+    ctx.incrementalAC = opts.incrementalAC;
+    ctx.valueOrdering = opts.valueOrdering;
+
+    // splitmix64 so neighbouring seeds (one per worker) don't start out correlated, xorshift can't start at 0
+    uint64_t seed = opts.randomSeed + 0x9E3779B97F4A7C15ull;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+    seed ^= seed >> 31;
+    ctx.randomState = seed ? seed : 1;
+}
+
+template <class Size, class Propagation, class Ordering>
+void SearchEngine<Size, Propagation, Ordering>::reset(const Solution &initial)
+{
+    initialState = initial;
+}
+
+template <class Size, class Propagation, class Ordering>
+void SearchEngine<Size, Propagation, Ordering>::initializeDomains()
+{
+    const int n = ctx.n;
+    const Word full = lowBits<Word>(n);
+    // symmetry breaking, row 0 only gets the left half
+    const Word rowZero = lowBits<Word>(firstRowLimit(n, options.symmetry));
+
+    // assigned rows get an empty domain, the others everything the placed queens don't attack
+    for (int row = 0; row < n; row++)
+    {
+        if (ctx.board[row] != -1)
+        {
+            ctx.domains[row] = emptyBits<Word>();
+            continue;
+        }
+
+        Word available = full;
+        for (int prevRow = 0; prevRow < n; prevRow++)
+        {
+            if (ctx.board[prevRow] != -1)
+                available &= ~ctx.attacks.mask(prevRow, row, ctx.board[prevRow]);
+        }
+
+        if (row == 0)
+            available &= rowZero;
+        else if (options.symmetry == SymmetryMode::Full && ctx.board[0] != -1)
+            available &= canonicalRowMask<Word>(n, ctx.board[0], row);
+
+        ctx.domains[row] = available;
+    }
+}
+
+// with full symmetry, once row 0 has its queen the other rows lose the columns no canonical board uses (canonicalRowMask)
+// goes through the trail like propagation does, false when a row is left with nothing
+template <class Size, class Propagation, class Ordering>
+bool SearchEngine<Size, Propagation, Ordering>::restrictToCanonical(int firstCol)
+{
+    Word rows = ctx.unassigned;
+    while (!isEmpty(rows))
+    {
+        int row = lowestBit(rows);
+        clearLowest(rows);
+
+        Word domain = ctx.domains[row] & canonicalRowMask<Word>(ctx.n, firstCol, row);
+        if (domain == ctx.domains[row])
+            continue;
+        if (isEmpty(domain))
+            return false;
+        ctx.trail.set(ctx.domains, row, domain);
+    }
+    return true;
+}
+
+// seeds at maxDepth go to the pool, full boards get counted
+// true when the state is done with, false when it still needs branching
+template <class Size, class Propagation, class Ordering>
+bool SearchEngine<Size, Propagation, Ordering>::finishState(int assigned)
+{
+    // if maxDepth is set and we've reached it, add to work queue instead of continuing
+    // this is only used for the seed generator solver
+    if (maxDepth > 0 && assigned == maxDepth)
+    {
+        workPool->pushSeed(ctx.asSolution(ctx.board));
+        return true;
+    }
+
+    // if solution is found
+    if (assigned == ctx.n)
+    {
+        recorder.record(ctx.asSolution(ctx.board));
+        return true;
+    }
+
+    return false;
+}
+
+template <class Size, class Propagation, class Ordering>
+void SearchEngine<Size, Propagation, Ordering>::solve()
+{
+    std::copy(initialState.begin(), initialState.end(), ctx.board.begin());
+    ctx.countUnassigned();
+    initializeDomains();
+    ctx.trail.clear();
+    frames.clear();
+
+    // every frame on the stack is one more assigned row
+    int initialAssigned = ctx.n - bitCount(ctx.unassigned);
+
+    // propagation gets a go at the initial state before anything is branched on, for AC3 that can already be a dead end
+    if (!finishState(initialAssigned) && Propagation::template prepare<Ordering>(ctx, initialAssigned - 1))
+    {
+        int row = Ordering::select(ctx, -1);
+        if (row != -1)
+            frames.push_back({row, Propagation::candidates(ctx, row), ctx.trail.mark()});
+    }
+
+    Solution donated;
+    while (!frames.empty())
+    {
+        // if another worker is idle, hand it the shallowest untried value, it has the biggest subtree left
+        // never done by the seed solver
+        if (workPool && maxDepth == 0 && workPool->wantsWork() && takeShallowest(frames, initialState, ctx.board, donated))
+            workPool->push(donated);
+
+        SearchFrame<Word> &frame = frames.back();
+
+        // whatever the last value of this row did to the domains gets undone
+        ctx.trail.undo(ctx.domains, frame.trailMark);
+
+        if (isEmpty(frame.remaining))
+        {
+            ctx.lift(frame.row);
+            frames.pop_back();
+
+            // only checked on the way back up, there's at most n rows worth of descent in between
+            if (options.limit && options.limit->stopRequested())
+                break;
+            continue;
+        }
+
+        int row = frame.row;
+        int col = ConfiguredValues::next(ctx, row, frame.remaining);
+        ctx.place(row, col);
+
+        if (row == 0 && options.symmetry == SymmetryMode::Full && !restrictToCanonical(col))
+            continue;
+
+        if (!Propagation::template assign<Ordering>(ctx, row, col) ||
+            finishState(initialAssigned + static_cast<int>(frames.size())))
+            continue;
+
+        int nextRow = Ordering::select(ctx, row);
+        if (nextRow == -1)
+            continue; // no valid row, but like, this shouldnt happen?
+
+        frames.push_back({nextRow, Propagation::candidates(ctx, nextRow), ctx.trail.mark()});
+    }
+
+    // push out whatever is left in the last partial batch
+    recorder.flush();
+}
+
+template <class Size, class Propagation, class Ordering>
+uint64_t SearchEngine<Size, Propagation, Ordering>::getSolutionCount() const
+{
+    return recorder.getSolutionCount();
+}
+
+template <class Size, class Propagation, class Ordering>
+uint64_t SearchEngine<Size, Propagation, Ordering>::getUniqueCount() const
+{
+    return recorder.getUniqueCount();
+}
+
+template <class Size, class Propagation, class Ordering>
+std::chrono::high_resolution_clock::time_point SearchEngine<Size, Propagation, Ordering>::getFirstSolutionTime() const
+{
+    return recorder.getFirstSolutionTime();
+}
+
+// makeSizedSolver wants a template on the size only
+template <class Propagation, class Ordering>
+struct EngineFor
+{
+    template <class Size>
+    using type = SearchEngine<Size, Propagation, Ordering>;
+};
+
+template <class Propagation, class Ordering>
+static std::unique_ptr<Solver> makeEngine(int boardSize, const Solution &initial, int maxDepth, WorkPool *wp, const SolverOptions &opts)
+{
+    return makeSizedSolver<EngineFor<Propagation, Ordering>::template type>(boardSize, initial, maxDepth, wp, opts);
+}
+
+std::unique_ptr<Solver> makeSearchEngine(const std::string &solverType, int boardSize, const Solution &initial, int maxDepth, WorkPool *wp, const SolverOptions &opts)
+{
+    if (solverType == "BT")
+        return makeEngine<NoPropagation, StaticOrder>(boardSize, initial, maxDepth, wp, opts);
+    if (solverType == "BT-FC")
+        return makeEngine<ForwardChecking, StaticOrder>(boardSize, initial, maxDepth, wp, opts);
+    if (solverType == "BT-FC-DVO")
+        return makeEngine<ForwardChecking, MRVOrder>(boardSize, initial, maxDepth, wp, opts);
+    if (solverType == "AC3")
+        return makeEngine<ArcConsistency, StaticOrder>(boardSize, initial, maxDepth, wp, opts);
+    if (solverType == "AC3-DVO")
+        return makeEngine<ArcConsistency, MRVOrder>(boardSize, initial, maxDepth, wp, opts);
+
+    return nullptr;
+}
+
+ValueOrdering parseValueOrdering(const std::string &value)
+{
+    if (value == "lcv")
+        return ValueOrdering::LeastConstraining;
+    if (value == "middle")
+        return ValueOrdering::MiddleOut;
+    if (value == "random")
+        return ValueOrdering::Random;
+    return ValueOrdering::Ascending;
+}
+
+std::string valueOrderingName(ValueOrdering ordering)
+{
+    switch (ordering)
+    {
+    case ValueOrdering::LeastConstraining:
+        return "lcv";
+    case ValueOrdering::MiddleOut:
+        return "middle";
+    case ValueOrdering::Random:
+        return "random";
+    default:
+        return "ascending";
+    }
+}
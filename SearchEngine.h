@@ -0,0 +1,58 @@
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+
+#include "Solver.h"
+#include "SearchPolicies.h"
+#include "WorkPool.h"
+#include "SolutionRecorder.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// the one domain based search, BT, BT-FC, BT-FC-DVO, AC3 and AC3-DVO are all instantiations of it
+// (see makeSearchEngine), they only differ in the policies from SearchPolicies.h:
+//   Propagation: NoPropagation, ForwardChecking, ArcConsistency
+//   Ordering:    StaticOrder, MRVOrder
+// the value order isn't a policy, every engine calls ConfiguredValues, which picks one at runtime
+// Size is the board size, compile time for the common sizes, runtime otherwise and multiword past 64, see BoardSize.h
+// the search is in place, one board and one domain array, changes go through a trail (SearchTrail.h)
+template <class Size, class Propagation, class Ordering>
+class SearchEngine : public Solver
+{
+private:
+    using Word = typename Size::Word;
+
+    SearchContext<Size> ctx;
+    Solution initialState;
+    SolutionRecorder recorder;
+    int maxDepth;
+    WorkPool *workPool;
+    SolverOptions options;
+
+    // one per row being branched on, kept between seeds
+    std::vector<SearchFrame<Word>> frames;
+
+    void initializeDomains();
+    bool restrictToCanonical(int firstCol);
+    bool finishState(int assigned);
+
+public:
+    SearchEngine(int boardSize, const Solution &initial, int maxDepth = 0, WorkPool *wp = nullptr, const SolverOptions &opts = SolverOptions());
+    void solve() override;
+    void reset(const Solution &initial) override;
+    uint64_t getSolutionCount() const override;
+    uint64_t getUniqueCount() const override;
+    std::chrono::high_resolution_clock::time_point getFirstSolutionTime() const override;
+};
+
+// the engine for solverType, sized for boardSize when possible
+// nullptr if solverType isn't an engine type or boardSize is over maxBoardSize
+std::unique_ptr<Solver> makeSearchEngine(const std::string &solverType, int boardSize, const Solution &initial, int maxDepth = 0, WorkPool *wp = nullptr, const SolverOptions &opts = SolverOptions());
+
+// "ascending", "lcv", "middle" or "random", anything else is ascending
+// (readConfig and portfolio entries reject other names by checking that valueOrderingName gives the value back)
+ValueOrdering parseValueOrdering(const std::string &value);
+std::string valueOrderingName(ValueOrdering ordering);
+
+#endif
@@ -0,0 +1,28 @@
+#include "SearchLimit.h"
+
+SearchLimit::SearchLimit(uint64_t maxSolutions) : stopped(false), found(0), maxSolutions(maxSolutions) {}
+
+void SearchLimit::cancel()
+{
+    stopped.store(true, std::memory_order_relaxed);
+}
+
+bool SearchLimit::admit(uint64_t weight)
+{
+    if (maxSolutions == 0)
+        return !stopRequested();
+
+    // one atomic add decides it, no matter how many workers hit a solution at the same time
+    uint64_t before = found.fetch_add(weight);
+    if (before >= maxSolutions)
+        return false;
+
+    if (before + weight >= maxSolutions)
+        cancel();
+    return true;
+}
+
+uint64_t SearchLimit::getMaxSolutions() const
+{
+    return maxSolutions;
+}
@@ -0,0 +1,35 @@
+#ifndef SEARCHLIMIT_H
+#define SEARCHLIMIT_H
+
+#include <atomic>
+#include <cstdint>
+
+// cancellation token shared by every solver, seeder and the work pool of a run
+// it trips once maxSolutions solutions are in (maxSolutions / firstOnly in the config) or when cancel() is called,
+// after that solvers bail out at their next backtrack and the pool drops whatever is still queued
+class SearchLimit
+{
+private:
+    std::atomic<bool> stopped;
+    std::atomic<uint64_t> found; // solutions admitted so far, weighted by symmetry like the solvers' counts
+    uint64_t maxSolutions;       // 0 = no limit, only cancel() stops the run
+
+public:
+    explicit SearchLimit(uint64_t maxSolutions = 0);
+
+    // cheap check for the solvers' loops, one relaxed load
+    bool stopRequested() const
+    {
+        return stopped.load(std::memory_order_relaxed);
+    }
+
+    void cancel();
+
+    // a solution standing for weight solutions is about to be counted, false if it has to be dropped instead
+    // the one that reaches the limit is still counted, so a run can overshoot by less than one solution's weight
+    bool admit(uint64_t weight);
+
+    uint64_t getMaxSolutions() const;
+};
+
+#endif
@@ -0,0 +1,530 @@
+#ifndef SEARCHPOLICIES_H
+#define SEARCHPOLICIES_H
+
+#include "BoardSize.h"
+#include "SearchTrail.h"
+#include "ForwardCheck.h"
+#include "RowSelect.h"
+#include <type_traits>
+#include <climits>
+
+// the pieces SearchEngine is put together from, see SearchEngine.h
+// every policy is a struct of static functions, so the engine's hot loop gets them inlined, nothing is virtual
+
+// what the policies work on, one per engine, Size is one of the board sizes from BoardSize.h
+// the policies below are templates on the context, Context::Word is the domain type (see DomainBits.h)
+template <class Size>
+struct SearchContext : Size
+{
+    using Word = typename Size::Word;
+    using Board = typename Size::Board;
+    using Domains = typename Size::Domains;
+
+    Board board;     // -1 = unassigned
+    Word unassigned; // the rows board has at -1, kept in step by place() and lift()
+    Domains domains; // domains[i] = bitmask of available columns for row i
+    Domains pruned;  // forwardCheck writes here, only the rows that changed get copied back through the trail
+    DomainTrail<Word> trail;
+
+    // AC3's worklist, arcs[i] has bit j set while the arc (i, j) waits to be revised, arcRows has bit i set while arcs[i] isn't empty
+    // row sets use the domain word too, there are as many rows as columns
+    // empty whenever AC3 isn't running, so it starts out zeroed (a fixed size board's std::array isn't otherwise)
+    Domains arcs;
+    Word arcRows;
+    bool incrementalAC = true; // AC3 only starts from the rows forward checking shrank, see ArcConsistency
+
+    // value ordering, see ConfiguredValues
+    ValueOrdering valueOrdering = ValueOrdering::Ascending;
+    Word middleLow;           // columns left of the middle and the middle one itself, for MiddleOutValues
+    uint64_t randomState = 1; // xorshift state for RandomValues, never 0
+
+    explicit SearchContext(int boardSize) : Size(boardSize), unassigned(), arcs(), arcRows(), middleLow(lowBits<Word>((this->n + 1) / 2))
+    {
+        this->allocate(board, domains);
+        this->allocate(pruned);
+        this->allocate(arcs);
+        trail.reserve(static_cast<size_t>(this->n) * this->n);
+    }
+
+    // after board was filled in from an initial state
+    void countUnassigned()
+    {
+        unassigned = emptyBits<Word>();
+        for (int row = 0; row < this->n; row++)
+        {
+            if (board[row] == -1)
+                setBit(unassigned, row);
+        }
+    }
+
+    void place(int row, int col)
+    {
+        board[row] = col;
+        clearBit(unassigned, row);
+    }
+
+    void lift(int row)
+    {
+        board[row] = -1;
+        setBit(unassigned, row);
+    }
+};
+
+// ---- row ordering ----
+
+// rows get assigned top to bottom, so the initial state is always a prefix
+struct StaticOrder
+{
+    // row to branch on after lastRow (-1 at the root), -1 if there's none left
+    template <class Context>
+    static int select(const Context &ctx, int lastRow)
+    {
+        for (int row = lastRow + 1; row < ctx.n; row++)
+        {
+            if (ctx.board[row] == -1)
+                return row;
+        }
+        return -1;
+    }
+
+    // calls visit(row) for every unassigned row, stops early (and returns false) when visit returns false
+    // lastRow is the row that was just assigned, everything below it is unassigned
+    template <class Context, class Visit>
+    static bool forEachUnassigned(const Context &ctx, int lastRow, Visit visit)
+    {
+        for (int row = lastRow + 1; row < ctx.n; row++)
+        {
+            if (!visit(row))
+                return false;
+        }
+        return true;
+    }
+};
+
+// dynamic variable ordering, the unassigned row with the fewest values left goes next (minimum remaining values)
+// only the unassigned rows get looked at, sizes are a popcount each, with 64 bit domains that's minDomainRow (RowSelect.h)
+// no cached sizes, every domain change would need its size on the trail too, and a popcount costs about the same as reading one
+struct MRVOrder
+{
+    template <class Context>
+    static int select(const Context &ctx, int)
+    {
+        if constexpr (std::is_same_v<typename Context::Word, uint64_t>)
+        {
+            return minDomainRow(ctx.domains.data(), ctx.n, ctx.unassigned);
+        }
+        else
+        {
+            int bestRow = -1;
+            int minDomainSize = ctx.n + 1;
+
+            typename Context::Word rows = ctx.unassigned;
+            while (!isEmpty(rows))
+            {
+                int row = lowestBit(rows);
+                clearLowest(rows);
+
+                int domainSize = bitCount(ctx.domains[row]);
+                if (domainSize < minDomainSize)
+                {
+                    minDomainSize = domainSize;
+                    bestRow = row;
+                }
+            }
+
+            return bestRow;
+        }
+    }
+
+    template <class Context, class Visit>
+    static bool forEachUnassigned(const Context &ctx, int, Visit visit)
+    {
+        typename Context::Word rows = ctx.unassigned;
+        while (!isEmpty(rows))
+        {
+            int row = lowestBit(rows);
+            clearLowest(rows);
+            if (!visit(row))
+                return false;
+        }
+        return true;
+    }
+};
+
+// ---- propagation ----
+// candidates(row) is what a row gets to branch on, assign(row, col) runs after the queen is on the board
+// prepare(lastRow) runs once on the initial state, lastRow is its last assigned row for StaticOrder
+// by the time either runs ctx.unassigned no longer has the row being assigned
+// assign and prepare change domains only through the trail, false means a dead end
+
+// plain backtracking, nothing gets propagated, a row's values are checked against the placed queens when it's branched on
+struct NoPropagation
+{
+    template <class Context>
+    static typename Context::Word candidates(const Context &ctx, int row)
+    {
+        typename Context::Word available = ctx.domains[row];
+        for (int prevRow = 0; prevRow < ctx.n; prevRow++)
+        {
+            if (ctx.board[prevRow] != -1)
+                available &= ~ctx.attacks.mask(prevRow, row, ctx.board[prevRow]);
+        }
+        return available;
+    }
+
+    template <class Ordering, class Context>
+    static bool prepare(Context &, int)
+    {
+        return true;
+    }
+
+    template <class Ordering, class Context>
+    static bool assign(Context &, int, int)
+    {
+        return true;
+    }
+};
+
+// forward checking, the new queen's attacks come out of every unassigned row, a wipeout kills the value
+// with 64 bit domains the pruning and the wipeout test run in one pass over all of them, see ForwardCheck.h
+// a wipeout leaves the domains alone, otherwise only the rows that actually lost a value hit the trail
+// wider domains go row by row
+struct ForwardChecking
+{
+    template <class Context>
+    static typename Context::Word candidates(const Context &ctx, int row)
+    {
+        return ctx.domains[row];
+    }
+
+    template <class Ordering, class Context>
+    static bool prepare(Context &, int)
+    {
+        return true;
+    }
+
+    // changedRows gets the rows that lost a value, only complete when this returns true
+    template <class Ordering, class Context>
+    static bool prune(Context &ctx, int row, int col, typename Context::Word &changedRows)
+    {
+        if constexpr (std::is_same_v<typename Context::Word, uint64_t>)
+        {
+            bool wipeout;
+            uint64_t changed = forwardCheck(ctx.domains.data(), ctx.pruned.data(), ctx.n, ctx.unassigned, row, col, wipeout);
+            if (wipeout)
+                return false;
+
+            changedRows = changed;
+            while (changed)
+            {
+                int futureRow = __builtin_ctzll(changed);
+                changed &= changed - 1;
+                ctx.trail.set(ctx.domains, futureRow, ctx.pruned[futureRow]);
+            }
+            return true;
+        }
+        else
+        {
+            changedRows = emptyBits<typename Context::Word>();
+            return Ordering::forEachUnassigned(ctx, row, [&ctx, &changedRows, row, col](int futureRow)
+            {
+                typename Context::Word futureDomain = ctx.domains[futureRow] & ~ctx.attacks.mask(row, futureRow, col);
+                if (futureDomain != ctx.domains[futureRow])
+                    setBit(changedRows, futureRow);
+                ctx.trail.set(ctx.domains, futureRow, futureDomain);
+                return !isEmpty(futureDomain);
+            });
+        }
+    }
+
+    template <class Ordering, class Context>
+    static bool assign(Context &ctx, int row, int col)
+    {
+        typename Context::Word changedRows;
+        return prune<Ordering>(ctx, row, col, changedRows);
+    }
+};
+
+// forward checking, then AC3 (maintaining arc consistency)
+// prepare makes the initial state arc consistent, after that every node starts out arc consistent:
+// its parent was, and backtracking restores exactly that through the trail
+// so after forward checking only arcs into the rows it shrank can have lost support, incremental mode only queues those,
+// with incrementalAC off every assignment queues every pair of unassigned rows again, same fixpoint, more revisions
+struct ArcConsistency
+{
+    template <class Context>
+    static typename Context::Word candidates(const Context &ctx, int row)
+    {
+        return ctx.domains[row];
+    }
+
+    // a queen attacks at most 3 squares of another row, so only a row with 3 values or less can leave a value elsewhere without support
+    template <class Word>
+    static bool canRemoveSupport(Word domain)
+    {
+        clearLowest(domain);
+        clearLowest(domain);
+        clearLowest(domain);
+        return isEmpty(domain);
+    }
+
+    // checks whether row1 is arc consistent with row2, nothing else
+    // a row2 with 4+ values supports all of row1 and there's nothing to do
+    // otherwise (row1, col1) has no support when every value left in row2 attacks it, attacks are symmetric,
+    // so the unsupported values are just the AND of what row2's (at most 3) values attack in row1, no per value scan
+    template <class Context>
+    static bool revise(Context &ctx, int row1, int row2)
+    {
+        using Word = typename Context::Word;
+        Word domain2 = ctx.domains[row2];
+        if (!canRemoveSupport(domain2))
+            return false;
+
+        Word unsupported = ~emptyBits<Word>();
+        while (!isEmpty(domain2))
+        {
+            unsupported &= ctx.attacks.mask(row2, row1, lowestBit(domain2));
+            clearLowest(domain2);
+        }
+
+        Word domain1 = ctx.domains[row1];
+        Word toRemove = domain1 & unsupported;
+
+        // if there has been a removal, return true to indicate dirty, and enforce has to readd
+        if (!isEmpty(toRemove))
+        {
+            ctx.trail.set(ctx.domains, row1, domain1 & ~toRemove);
+            return true;
+        }
+
+        return false;
+    }
+
+    // queues (k, row) for every k in rows but row itself, an arc that's already queued just stays queued
+    // nothing to queue while row still has 4+ values, revise would pass on every one of those arcs
+    template <class Context>
+    static void queueArcsInto(Context &ctx, typename Context::Word rows, int row)
+    {
+        if (!canRemoveSupport(ctx.domains[row]))
+            return;
+
+        clearBit(rows, row);
+        while (!isEmpty(rows))
+        {
+            int k = lowestBit(rows);
+            clearLowest(rows);
+            setBit(ctx.arcs[k], row);
+            setBit(ctx.arcRows, k);
+        }
+    }
+
+    // revises queued arcs until the worklist is empty, false on a wipeout
+    template <class Context>
+    static bool run(Context &ctx)
+    {
+        using Word = typename Context::Word;
+
+        while (!isEmpty(ctx.arcRows))
+        {
+            int row1 = lowestBit(ctx.arcRows);
+            int row2 = lowestBit(ctx.arcs[row1]);
+            clearLowest(ctx.arcs[row1]);
+            if (isEmpty(ctx.arcs[row1]))
+                clearBit(ctx.arcRows, row1);
+
+            if (!revise(ctx, row1, row2))
+                continue;
+
+            // if there is no remaining options for row1
+            if (isEmpty(ctx.domains[row1]))
+            {
+                // domain wipeout, this timeline is a deadend, the leftover arcs go
+                while (!isEmpty(ctx.arcRows))
+                {
+                    ctx.arcs[lowestBit(ctx.arcRows)] = emptyBits<Word>();
+                    clearLowest(ctx.arcRows);
+                }
+                return false;
+            }
+
+            // re add all arcs pointing to row1 to reevaluate, except row2 since we just did that
+            Word others = ctx.unassigned;
+            clearBit(others, row2);
+            queueArcsInto(ctx, others, row1);
+        }
+
+        return true;
+    }
+
+    // every pair of unassigned rows
+    template <class Context>
+    static bool enforce(Context &ctx)
+    {
+        typename Context::Word rows = ctx.unassigned;
+        while (!isEmpty(rows))
+        {
+            queueArcsInto(ctx, ctx.unassigned, lowestBit(rows));
+            clearLowest(rows);
+        }
+        return run(ctx);
+    }
+
+    template <class Ordering, class Context>
+    static bool prepare(Context &ctx, int)
+    {
+        return enforce(ctx);
+    }
+
+    template <class Ordering, class Context>
+    static bool assign(Context &ctx, int row, int col)
+    {
+        typename Context::Word changedRows;
+        if (!ForwardChecking::prune<Ordering>(ctx, row, col, changedRows))
+            return false;
+
+        if (!ctx.incrementalAC)
+            return enforce(ctx);
+
+        // only arcs into the rows that just shrank
+        while (!isEmpty(changedRows))
+        {
+            queueArcsInto(ctx, ctx.unassigned, lowestBit(changedRows));
+            clearLowest(changedRows);
+        }
+        return run(ctx);
+    }
+};
+
+// ---- value ordering ----
+// next(row, remaining) picks the value to try and takes it out of remaining
+// it's called with the domains as they were before any of row's values was tried, so scores don't drift between calls
+
+// lowest column first
+struct AscendingValues
+{
+    template <class Context>
+    static int next(const Context &, int, typename Context::Word &remaining)
+    {
+        int col = lowestBit(remaining);
+        clearLowest(remaining);
+        return col;
+    }
+};
+
+// the value that removes the fewest values from the other unassigned rows first (least constraining value), lowest column on ties
+// a value's score is how many of its attacked squares are still in those rows' domains
+template <class Context>
+struct LeastConstrainingValues
+{
+    static int next(const Context &ctx, int row, typename Context::Word &remaining)
+    {
+        using Word = typename Context::Word;
+
+        Word others = ctx.unassigned;
+        clearBit(others, row);
+
+        int bestCol = -1;
+        int bestScore = INT_MAX;
+        Word values = remaining;
+        while (!isEmpty(values))
+        {
+            int col = lowestBit(values);
+            clearLowest(values);
+
+            int score = 0;
+            Word rows = others;
+            while (!isEmpty(rows) && score < bestScore)
+            {
+                int futureRow = lowestBit(rows);
+                clearLowest(rows);
+                score += bitCount(ctx.domains[futureRow] & ctx.attacks.mask(row, futureRow, col));
+            }
+
+            if (score < bestScore)
+            {
+                bestScore = score;
+                bestCol = col;
+            }
+        }
+
+        clearBit(remaining, bestCol);
+        return bestCol;
+    }
+};
+
+// the column closest to the middle first, left one on ties
+template <class Context>
+struct MiddleOutValues
+{
+    static int next(const Context &ctx, int, typename Context::Word &remaining)
+    {
+        using Word = typename Context::Word;
+
+        Word left = remaining & ctx.middleLow;
+        Word right = remaining & ~ctx.middleLow;
+
+        int col;
+        if (isEmpty(right))
+            col = highestBit(left);
+        else if (isEmpty(left))
+            col = lowestBit(right);
+        else
+        {
+            // distances doubled, for even n the middle is between two columns
+            int leftCol = highestBit(left);
+            int rightCol = lowestBit(right);
+            col = (ctx.n - 1 - 2 * leftCol <= 2 * rightCol - (ctx.n - 1)) ? leftCol : rightCol;
+        }
+
+        clearBit(remaining, col);
+        return col;
+    }
+};
+
+// a uniformly random untried value
+template <class Context>
+struct RandomValues
+{
+    static int next(Context &ctx, int, typename Context::Word &remaining)
+    {
+        // xorshift64
+        uint64_t x = ctx.randomState;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        ctx.randomState = x;
+
+        typename Context::Word values = remaining;
+        for (int skip = static_cast<int>(x % static_cast<uint64_t>(bitCount(remaining))); skip > 0; skip--)
+        {
+            clearLowest(values);
+        }
+
+        int col = lowestBit(values);
+        clearBit(remaining, col);
+        return col;
+    }
+};
+
+// whichever of the above the run was configured with (ctx.valueOrdering), one engine covers all of them,
+// the switch goes the same way on every call so it costs next to nothing, and it keeps the engine count from multiplying
+struct ConfiguredValues
+{
+    template <class Context>
+    static int next(Context &ctx, int row, typename Context::Word &remaining)
+    {
+        switch (ctx.valueOrdering)
+        {
+        case ValueOrdering::LeastConstraining:
+            return LeastConstrainingValues<Context>::next(ctx, row, remaining);
+        case ValueOrdering::MiddleOut:
+            return MiddleOutValues<Context>::next(ctx, row, remaining);
+        case ValueOrdering::Random:
+            return RandomValues<Context>::next(ctx, row, remaining);
+        default:
+            return AscendingValues::next(ctx, row, remaining);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SEARCHTRAIL_H
+#define SEARCHTRAIL_H
+
+#include "Solver.h"
+#include "DomainBits.h"
+#include <vector>
+#include <cstdint>
+
+// in place search for the domain based solvers (FC, AC3 and their DVO versions)
+// there's one board and one domain array per solve, children change them in place
+// every domain change goes through the trail first, so backtracking only restores what actually changed
+
+// Word is the domain type, see DomainBits.h
+template <class Word>
+struct TrailEntry
+{
+    int row;
+    Word domain; // value before the change
+};
+
+template <class Word>
+class DomainTrail
+{
+private:
+    std::vector<TrailEntry<Word>> entries;
+
+public:
+    void reserve(size_t size)
+    {
+        entries.reserve(size);
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+    size_t mark() const
+    {
+        return entries.size();
+    }
+
+    // logs the old value only when something actually changes
+    // Domains is a std::vector or std::array of Word, see BoardSize.h
+    template <class Domains>
+    void set(Domains &domains, int row, const Word &value)
+    {
+        if (domains[row] == value)
+            return;
+        entries.push_back({row, domains[row]});
+        domains[row] = value;
+    }
+
+    // back to how the domains were when mark was taken, newest change first
+    template <class Domains>
+    void undo(Domains &domains, size_t toMark)
+    {
+        while (entries.size() > toMark)
+        {
+            const TrailEntry<Word> &entry = entries.back();
+            domains[entry.row] = entry.domain;
+            entries.pop_back();
+        }
+    }
+};
+
+// one per row being branched on, replaces the stack of full board + domains copies
+template <class Word>
+struct SearchFrame
+{
+    int row;
+    Word remaining;     // values of row not tried yet
+    size_t trailMark;   // trail size before any value of row was tried
+};
+
+// donation for the in place solvers, takes the last value of the shallowest frame with something left,
+// it has the biggest subtree, the top frame is the one being worked on so it's left alone
+// the state is the initial board plus whatever the frames below it currently have assigned
+template <class Word, class Board>
+bool takeShallowest(std::vector<SearchFrame<Word>> &frames, const Solution &initial, const Board &board, Solution &out)
+{
+    for (size_t d = 0; d + 1 < frames.size(); d++)
+    {
+        if (isEmpty(frames[d].remaining))
+            continue;
+
+        int col = highestBit(frames[d].remaining);
+        clearBit(frames[d].remaining, col);
+
+        out = initial;
+        for (size_t i = 0; i < d; i++)
+        {
+            out[frames[i].row] = board[frames[i].row];
+        }
+        out[frames[d].row] = col;
+        return true;
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include "SeedSpace.h"
+#include <cmath>
+#include <algorithm>
+
+SeedSpace::SeedSpace(int boardSize, int depth, int nWorkers, int rowZeroLimit)
+    : n(boardSize), depth(depth), total(1), chunkSize(1), nextIndex(0), decoded(0)
+{
+    if (this->depth < 1)
+        this->depth = 1;
+    if (this->depth > n)
+        this->depth = n;
+
+    // largest depth whose index space still fits in a uint64
+    int fits = 0;
+    total = 1;
+    while (fits < this->depth && total <= UINT64_MAX / n)
+    {
+        total *= n;
+        fits++;
+    }
+    this->depth = fits;
+
+    blockSize.resize(this->depth);
+    uint64_t block = 1;
+    for (int k = this->depth - 1; k >= 0; k--)
+    {
+        blockSize[k] = block;
+        block *= n;
+    }
+
+    // row 0 is the most significant digit, so restricting it just shortens the space
+    if (rowZeroLimit < n)
+        total = blockSize[0] * rowZeroLimit;
+
+    // plenty of chunks per worker so the tail stays short, but few enough that the atomic isn't hot
+    uint64_t chunks = static_cast<uint64_t>(std::max(nWorkers, 1)) * 256;
+    chunkSize = std::max<uint64_t>(1, total / chunks);
+}
+
+bool SeedSpace::claim(uint64_t &begin, uint64_t &end)
+{
+    // cheap early out, keeps nextIndex from creeping towards overflow once everything is claimed
+    if (nextIndex.load(std::memory_order_relaxed) >= total)
+        return false;
+
+    begin = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+    if (begin >= total)
+        return false;
+
+    end = std::min(begin + chunkSize, total);
+    return true;
+}
+
+bool SeedSpace::next(uint64_t &cursor, uint64_t end, Solution &board)
+{
+    while (cursor < end)
+    {
+        int badRow = -1;
+
+        for (int k = 0; k < depth && badRow == -1; k++)
+        {
+            int col = static_cast<int>((cursor / blockSize[k]) % n);
+            board[k] = col;
+
+            // column and diagonal checks against the rows already decoded, what the attack masks cover in the engine
+            for (int i = 0; i < k; i++)
+            {
+                if (board[i] == col || abs(board[i] - col) == k - i)
+                {
+                    badRow = k;
+                    break;
+                }
+            }
+        }
+
+        if (badRow == -1)
+        {
+            std::fill(board.begin() + depth, board.end(), -1);
+            cursor++;
+            decoded.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // every index sharing the prefix up to badRow conflicts too, jump past all of them
+        cursor = (cursor / blockSize[badRow] + 1) * blockSize[badRow];
+    }
+
+    return false;
+}
+
+int SeedSpace::getDepth() const
+{
+    return depth;
+}
+
+uint64_t SeedSpace::size() const
+{
+    return total;
+}
+
+uint64_t SeedSpace::decodedCount() const
+{
+    return decoded.load();
+}
@@ -0,0 +1,41 @@
+#ifndef SEEDSPACE_H
+#define SEEDSPACE_H
+
+#include "Solver.h"
+#include <atomic>
+#include <cstdint>
+
+// lazy, index addressed seed space, nothing gets materialized
+// seed i is the prefix of the first `depth` rows, read as the base n digits of i (row 0 = most significant)
+// workers claim index ranges with one atomic add, and only decode a seed into a board once they own it
+// indices whose prefix has a conflict are skipped in whole blocks while decoding
+class SeedSpace
+{
+private:
+    int n;
+    int depth;
+    uint64_t total;     // n^depth
+    uint64_t chunkSize; // indices handed out per claim
+    std::vector<uint64_t> blockSize; // blockSize[k] = n^(depth - 1 - k), indices sharing the same k+1 row prefix
+
+    std::atomic<uint64_t> nextIndex;
+    std::atomic<uint64_t> decoded; // valid seeds handed out, just for reporting
+
+public:
+    // depth gets clamped so n^depth fits in 64 bits
+    // rowZeroLimit cuts row 0 to columns [0, rowZeroLimit), for symmetry breaking
+    SeedSpace(int boardSize, int depth, int nWorkers, int rowZeroLimit);
+
+    // claim the next range of indices, false once the space is used up
+    bool claim(uint64_t &begin, uint64_t &end);
+
+    // decode the next valid seed at or after cursor and before end into board, advances cursor past it
+    // board must already be sized n, rows past depth are reset to -1
+    bool next(uint64_t &cursor, uint64_t end, Solution &board);
+
+    int getDepth() const;
+    uint64_t size() const;
+    uint64_t decodedCount() const;
+};
+
+#endif
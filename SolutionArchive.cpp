@@ -0,0 +1,201 @@
+#include "SolutionArchive.h"
+#include "PackedSolutionFile.h"
+#include <cstdio>
+#include <cstring>
+
+static const char archiveMagic[8] = {'N', 'Q', 'S', 'O', 'L', 'A', 'R', 'C'};
+static const uint32_t archiveVersion = 1;
+
+struct ArchiveHeader
+{
+    char magic[8]; // "NQSOLARC"
+    uint32_t version;
+    uint32_t boardSize;
+    uint32_t bitsPerColumn;
+    uint32_t symmetry;
+    uint64_t count;
+    uint64_t bitLength;
+    char solverType[24];
+};
+
+static_assert(sizeof(ArchiveHeader) == 64, "header layout is part of the file format");
+
+SolutionArchive::SolutionArchive(int boardSize)
+    : n(boardSize), bitsPerColumn(packedBitsPerColumn(boardSize > 0 ? boardSize : 1)), count(0), bitLength(0) {}
+
+void SolutionArchive::writeBits(uint64_t value, int nBits)
+{
+    uint64_t word = bitLength >> 6;
+    int offset = static_cast<int>(bitLength & 63);
+
+    if (words.size() < word + 2)
+        words.resize(word + 2, 0);
+
+    words[word] |= value << offset;
+    if (offset + nBits > 64)
+        words[word + 1] |= value >> (64 - offset);
+
+    bitLength += nBits;
+}
+
+static uint64_t readBits(const std::vector<uint64_t> &words, uint64_t pos, int nBits)
+{
+    uint64_t word = pos >> 6;
+    int offset = static_cast<int>(pos & 63);
+
+    uint64_t value = words[word] >> offset;
+    if (offset + nBits > 64)
+        value |= words[word + 1] << (64 - offset);
+
+    return value & ((1ULL << nBits) - 1);
+}
+
+void SolutionArchive::append(const Solution &sol)
+{
+    // shared prefix with the previous solution, capped at n - 1 since the last column is implied anyway
+    int prefix = 0;
+    if (count > 0)
+    {
+        while (prefix < n - 1 && previous[prefix] == sol[prefix])
+            prefix++;
+    }
+
+    writeBits(prefix, bitsPerColumn);
+    for (int row = prefix; row < n - 1; row++)
+    {
+        writeBits(sol[row], bitsPerColumn);
+    }
+
+    previous = sol;
+    count++;
+}
+
+void SolutionArchive::forEach(const std::function<void(const Solution &)> &visit) const
+{
+    Solution current(n, 0);
+    uint64_t pos = 0;
+
+    // columns of a solution are a permutation of 0..n-1, so the last one is whatever the sum is missing
+    int64_t columnSum = static_cast<int64_t>(n) * (n - 1) / 2;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int prefix = static_cast<int>(readBits(words, pos, bitsPerColumn));
+        pos += bitsPerColumn;
+
+        int64_t sum = 0;
+        for (int row = 0; row < n - 1; row++)
+        {
+            if (row >= prefix)
+            {
+                current[row] = static_cast<int>(readBits(words, pos, bitsPerColumn));
+                pos += bitsPerColumn;
+            }
+            sum += current[row];
+        }
+        current[n - 1] = static_cast<int>(columnSum - sum);
+
+        visit(current);
+    }
+}
+
+uint64_t SolutionArchive::size() const
+{
+    return count;
+}
+
+uint64_t SolutionArchive::byteSize() const
+{
+    return (bitLength + 7) / 8;
+}
+
+int SolutionArchive::getBoardSize() const
+{
+    return n;
+}
+
+bool SolutionArchive::save(const std::string &filename, const std::string &solverType, SymmetryMode symmetry) const
+{
+    FILE *file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    ArchiveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+    header.version = archiveVersion;
+    header.boardSize = n;
+    header.bitsPerColumn = bitsPerColumn;
+    header.symmetry = static_cast<uint32_t>(symmetry);
+    header.count = count;
+    header.bitLength = bitLength;
+    std::strncpy(header.solverType, solverType.c_str(), sizeof(header.solverType) - 1);
+
+    // a zeroed header goes first and the real one only once the stream is down,
+    // so a write that runs out of disk leaves a file load() rejects instead of a short one that looks valid
+    ArchiveHeader blank;
+    std::memset(&blank, 0, sizeof(blank));
+    bool ok = std::fwrite(&blank, sizeof(blank), 1, file) == 1;
+    // whole words, so load() can read straight back into the vector
+    uint64_t nWords = (bitLength + 63) / 64;
+    ok = ok && std::fwrite(words.data(), sizeof(uint64_t), nWords, file) == nWords;
+    ok = ok && std::fflush(file) == 0;
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (std::fclose(file) != 0)
+        ok = false;
+    return ok;
+}
+
+bool SolutionArchive::load(const std::string &filename)
+{
+    FILE *file = std::fopen(filename.c_str(), "rb");
+    if (!file)
+        return false;
+
+    ArchiveHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, archiveMagic, sizeof(archiveMagic)) != 0 ||
+        header.version != archiveVersion)
+    {
+        std::fclose(file);
+        return false;
+    }
+
+    n = header.boardSize;
+    bitsPerColumn = header.bitsPerColumn;
+    count = header.count;
+    bitLength = header.bitLength;
+
+    uint64_t nWords = (bitLength + 63) / 64;
+    words.assign(nWords + 1, 0); // +1 so readBits can always peek at the next word
+    bool ok = std::fread(words.data(), sizeof(uint64_t), nWords, file) == nWords;
+    std::fclose(file);
+
+    // appending after a load needs the last solution to delta against
+    previous.clear();
+    if (ok && count > 0)
+    {
+        forEach([this](const Solution &sol)
+        {
+            previous = sol;
+        });
+    }
+    return ok;
+}
+
+ArchiveSink::ArchiveSink(int boardSize)
+    : archive(boardSize) {}
+
+void ArchiveSink::consume(const std::vector<Solution> &batch)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Solution &sol : batch)
+    {
+        archive.append(sol);
+    }
+}
+
+const SolutionArchive &ArchiveSink::getArchive() const
+{
+    return archive;
+}
@@ -0,0 +1,57 @@
+#ifndef SOLUTIONARCHIVE_H
+#define SOLUTIONARCHIVE_H
+
+#include "SolutionSink.h"
+#include <cstdint>
+#include <string>
+#include <functional>
+
+// compressed solution set, delta from previous encoding (a flattened prefix trie)
+// DFS order means neighbouring solutions share long prefixes, so each solution is stored as
+//   [shared prefix length with the previous one][the remaining columns, minus the last]
+// the last column is never stored, it's the one column the other rows didn't use
+// everything is bitsPerColumn = ceil(log2 n) bits wide, in one continuous bit stream
+class SolutionArchive
+{
+private:
+    int n;
+    int bitsPerColumn;
+    uint64_t count;
+    uint64_t bitLength;
+    std::vector<uint64_t> words;
+    Solution previous;
+
+    void writeBits(uint64_t value, int nBits);
+
+public:
+    explicit SolutionArchive(int boardSize = 0);
+
+    void append(const Solution &sol);
+    // decodes everything in order, solutions come out exactly as they were appended
+    void forEach(const std::function<void(const Solution &)> &visit) const;
+
+    uint64_t size() const;
+    uint64_t byteSize() const;
+    int getBoardSize() const;
+
+    // [header like PackedSolutionHeader, magic "NQSOLARC"][bit stream]
+    // save() is false if anything didn't make it to disk, the header is only valid when it's true
+    bool save(const std::string &filename, const std::string &solverType, SymmetryMode symmetry) const;
+    bool load(const std::string &filename);
+};
+
+// keeps the archive in memory while the run goes, compressed
+// batches from one solver stay together, so the deltas stay small
+class ArchiveSink : public SolutionSink
+{
+private:
+    SolutionArchive archive;
+    std::mutex mutex;
+
+public:
+    explicit ArchiveSink(int boardSize);
+    void consume(const std::vector<Solution> &batch) override;
+    const SolutionArchive &getArchive() const;
+};
+
+#endif
@@ -0,0 +1,16 @@
+#include "SolutionRecorder.h"
+
+void SolutionRecorder::record(const Solution &board)
+{
+    int weight = symmetryWeight(board, symmetry);
+    if (weight == 0)
+        return;
+
+    // the run's solution limit is already reached, this one doesn't count
+    if (limit && !limit->admit(weight))
+        return;
+
+    count(weight);
+    if (output)
+        output->add(board);
+}
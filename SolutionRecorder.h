@@ -0,0 +1,86 @@
+#ifndef SOLUTIONRECORDER_H
+#define SOLUTIONRECORDER_H
+
+#include "Solver.h"
+#include "SolutionSink.h"
+#include "SearchLimit.h"
+#include "Symmetry.h"
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+// what every solver does with a full board it found, in one place: symmetry weight, the run's solution limit,
+// the counts, time to first solution and the output buffer
+// one per solver, so nothing in here is shared between threads (the limit does its own synchronization)
+class SolutionRecorder
+{
+private:
+    std::unique_ptr<SolutionBuffer> output; // null when there's no sink or counting only
+    SymmetryMode symmetry;
+    SearchLimit *limit;
+    uint64_t solutionCount; // weighted by symmetry
+    uint64_t uniqueCount;
+    std::chrono::high_resolution_clock::time_point firstSolutionTime;
+    bool foundFirst;
+
+    void count(uint64_t weight)
+    {
+        solutionCount += weight;
+        uniqueCount++;
+        if (!foundFirst)
+        {
+            firstSolutionTime = std::chrono::high_resolution_clock::now();
+            foundFirst = true;
+        }
+    }
+
+public:
+    // no output when there's no sink or the run only counts
+    explicit SolutionRecorder(const SolverOptions &opts)
+        : symmetry(opts.symmetry), limit(opts.limit), solutionCount(0), uniqueCount(0), foundFirst(false)
+    {
+        if (opts.sink && !opts.countOnly)
+            output = std::make_unique<SolutionBuffer>(opts.sink, opts.sinkBatchSize, opts.symmetry);
+    }
+
+    // with symmetry breaking one board can stand for several solutions, or none if it isn't canonical
+    // out of line on purpose, inlined into BT-BITS' loop it costs registers the search needs
+    void record(const Solution &board);
+
+    // false when every board counts once and goes nowhere, then recordPlain() does without building the board
+    bool needsBoard() const
+    {
+        return symmetry != SymmetryMode::None || output;
+    }
+
+    void recordPlain()
+    {
+        if (limit && !limit->admit(1))
+            return;
+        count(1);
+    }
+
+    // push out whatever is left in the last partial batch
+    void flush()
+    {
+        if (output)
+            output->flush();
+    }
+
+    uint64_t getSolutionCount() const
+    {
+        return solutionCount;
+    }
+
+    uint64_t getUniqueCount() const
+    {
+        return uniqueCount;
+    }
+
+    std::chrono::high_resolution_clock::time_point getFirstSolutionTime() const
+    {
+        return firstSolutionTime;
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "SolutionSink.h"
+#include "Symmetry.h"
+
+SolutionBuffer::SolutionBuffer(SolutionSink *sink, size_t batchSize, SymmetryMode symmetry)
+    : sink(sink), batchSize(batchSize > 0 ? batchSize : 1), symmetry(symmetry)
+{
+    // nothing reserved up front, a big batchSize only costs memory once that many solutions actually come in
+}
+
+SolutionBuffer::~SolutionBuffer()
+{
+    flush();
+}
+
+void SolutionBuffer::add(const Solution &sol)
+{
+    if (symmetry == SymmetryMode::None)
+    {
+        batch.push_back(sol);
+    }
+    else
+    {
+        for (Solution &image : expandSymmetric(sol, symmetry))
+        {
+            batch.push_back(std::move(image));
+        }
+    }
+
+    if (batch.size() >= batchSize)
+        flush();
+}
+
+void SolutionBuffer::flush()
+{
+    if (batch.empty())
+        return;
+
+    sink->consume(batch);
+    batch.clear(); // keeps the capacity for the next batch
+}
+
+TextFileSink::TextFileSink(const std::string &filename)
+    : file(filename), failed(!file) {}
+
+void TextFileSink::consume(const std::vector<Solution> &batch)
+{
+    // format the batch outside the lock, then one write while holding it
+    std::string text;
+    for (const Solution &sol : batch)
+    {
+        for (int col : sol)
+        {
+            // don't print visually, makes massive outputs. just do raw variables
+            text += std::to_string(col);
+            text += ' ';
+        }
+        text += '\n';
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (failed)
+        return;
+    file << text;
+    if (!file)
+        failed = true;
+}
+
+void TextFileSink::close()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file.is_open())
+        return;
+    // close() flushes whatever is still buffered, a full disk often only shows up here
+    file.close();
+    if (!file)
+        failed = true;
+}
+
+bool TextFileSink::good()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !failed;
+}
+
+void TeeSink::add(SolutionSink *sink)
+{
+    sinks.push_back(sink);
+}
+
+bool TeeSink::empty() const
+{
+    return sinks.empty();
+}
+
+void TeeSink::consume(const std::vector<Solution> &batch)
+{
+    for (SolutionSink *sink : sinks)
+    {
+        sink->consume(batch);
+    }
+}
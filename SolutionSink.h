@@ -0,0 +1,66 @@
+#ifndef SOLUTIONSINK_H
+#define SOLUTIONSINK_H
+
+#include "Solver.h"
+#include <mutex>
+#include <fstream>
+#include <string>
+#include <cstddef>
+
+// receives solutions while the solvers are still running, in batches
+// consume() gets called from worker threads, so every sink has to be thread safe
+class SolutionSink
+{
+public:
+    virtual ~SolutionSink() = default;
+    virtual void consume(const std::vector<Solution> &batch) = 0;
+};
+
+// one per solver (so per thread), sits in front of a shared sink and flushes every batchSize solutions
+// memory is bounded by the batch, not the solution count
+// boards found under symmetry breaking get expanded here, so sinks always see the real solution set
+class SolutionBuffer
+{
+private:
+    SolutionSink *sink;
+    size_t batchSize;
+    SymmetryMode symmetry;
+    std::vector<Solution> batch;
+
+public:
+    SolutionBuffer(SolutionSink *sink, size_t batchSize, SymmetryMode symmetry);
+    ~SolutionBuffer();
+
+    void add(const Solution &sol);
+    void flush();
+};
+
+// streams raw columns, one solution per line, straight to disk
+// good() turns false once the open, a write or the close fails, the shard is incomplete after that
+class TextFileSink : public SolutionSink
+{
+private:
+    std::ofstream file;
+    std::mutex mutex;
+    bool failed;
+
+public:
+    explicit TextFileSink(const std::string &filename);
+    void consume(const std::vector<Solution> &batch) override;
+    void close();
+    bool good();
+};
+
+// hands every batch to several sinks, e.g. print and save at the same time
+class TeeSink : public SolutionSink
+{
+private:
+    std::vector<SolutionSink *> sinks;
+
+public:
+    void add(SolutionSink *sink);
+    bool empty() const;
+    void consume(const std::vector<Solution> &batch) override;
+};
+
+#endif
@@ -3,16 +3,63 @@
 
 #include <vector>
 #include <chrono>
+#include <cstdint>
+#include <cstddef>
 
 // TODO: update all solvers to use solution instead of vector int
 using Solution = std::vector<int>;
 
+// how much board symmetry the solvers break, see Symmetry.h
+// Mirror: row 0 only takes the left half of the columns, every solution found also stands for its mirror
+// Full: on top of that only D4 canonical solutions are kept, each one stands for its whole orbit
+enum class SymmetryMode
+{
+    None,
+    Mirror,
+    Full
+};
+
+// the order a row's values get tried in, see the value ordering policies in SearchPolicies.h
+// Ascending: lowest column first
+// LeastConstraining: the value that takes the fewest values away from the unassigned rows first
+// MiddleOut: columns closest to the middle first
+// Random: a random untried value each time, seeded per solver
+enum class ValueOrdering
+{
+    Ascending,
+    LeastConstraining,
+    MiddleOut,
+    Random
+};
+
+class SolutionSink;
+class SearchLimit;
+
+// options shared by every solver type
+struct SolverOptions
+{
+    SymmetryMode symmetry = SymmetryMode::None;
+    bool countOnly = false;        // only bump the counters, never emit a solution
+    SolutionSink *sink = nullptr;  // where solutions are streamed to as they're found, see SolutionSink.h
+    size_t sinkBatchSize = 1024;   // solutions buffered per solver before a flush into the sink
+    bool incrementalAC = true;     // AC3 only revisits arcs into rows that just shrank, false requeues every pair per node
+    ValueOrdering valueOrdering = ValueOrdering::Ascending; // engine types only
+    uint64_t randomSeed = 1;       // for ValueOrdering::Random
+    SearchLimit *limit = nullptr;  // shared cancellation token, see SearchLimit.h, null = always run to the end
+};
+
 class Solver
 {
 public:
     virtual ~Solver() = default;
     virtual void solve() = 0;
-    virtual const std::vector<Solution> &getSolutions() const = 0;
+    // re-arm for another initial state, so one solver per thread can work through every seed
+    // stacks and buffers are kept, counts and the first solution time keep accumulating across seeds
+    virtual void reset(const Solution &initial) = 0;
+    // total solutions found, including the ones only represented through symmetry
+    virtual uint64_t getSolutionCount() const = 0;
+    // D4 canonical solutions found, only meaningful with SymmetryMode::Full
+    virtual uint64_t getUniqueCount() const = 0;
     virtual std::chrono::high_resolution_clock::time_point getFirstSolutionTime() const = 0;
 };
 
@@ -0,0 +1,179 @@
+#include "Symmetry.h"
+#include <algorithm>
+
+int firstRowLimit(int n, SymmetryMode mode)
+{
+    if (mode == SymmetryMode::None)
+        return n;
+
+    // left half, plus the middle column when n is odd
+    return (n + 1) / 2;
+}
+
+uint64_t firstRowMask(int n, SymmetryMode mode)
+{
+    int limit = firstRowLimit(n, mode);
+    return limit >= 64 ? ~0ULL : (1ULL << limit) - 1;
+}
+
+// the 8 elements of D4 applied to a board, t = 0 is the identity
+// a queen at (r, c) moves to the new (row, col) listed per case
+static Solution transformBoard(const Solution &sol, int t)
+{
+    int n = static_cast<int>(sol.size());
+    Solution out(n, -1);
+
+    for (int r = 0; r < n; r++)
+    {
+        int c = sol[r];
+        switch (t)
+        {
+        case 0: // identity
+            out[r] = c;
+            break;
+        case 1: // rotate 90, (c, n-1-r)
+            out[c] = n - 1 - r;
+            break;
+        case 2: // rotate 180, (n-1-r, n-1-c)
+            out[n - 1 - r] = n - 1 - c;
+            break;
+        case 3: // rotate 270, (n-1-c, r)
+            out[n - 1 - c] = r;
+            break;
+        case 4: // mirror columns, (r, n-1-c)
+            out[r] = n - 1 - c;
+            break;
+        case 5: // mirror rows, (n-1-r, c)
+            out[n - 1 - r] = c;
+            break;
+        case 6: // main diagonal, (c, r)
+            out[c] = r;
+            break;
+        case 7: // anti diagonal, (n-1-c, n-1-r)
+            out[n - 1 - c] = n - 1 - r;
+            break;
+        }
+    }
+
+    return out;
+}
+
+int symmetryWeight(const Solution &sol, SymmetryMode mode)
+{
+    int n = static_cast<int>(sol.size());
+
+    if (mode == SymmetryMode::None)
+        return 1;
+
+    if (mode == SymmetryMode::Mirror)
+    {
+        // the middle column of an odd board is its own mirror in row 0, so it was explored in full
+        return (n % 2 == 1 && sol[0] == n / 2) ? 1 : 2;
+    }
+
+    // full D4, keep only the lexicographically smallest board of the orbit
+    // the smallest one has the smallest row 0 column, so the mirror restriction never cuts it
+    // the images are compared row by row as they're read off sol and its inverse (the row of each column's queen),
+    // nothing gets built, and most of them already differ in row 0
+    thread_local Solution inverse;
+    inverse.resize(n);
+    for (int r = 0; r < n; r++)
+    {
+        inverse[sol[r]] = r;
+    }
+
+    int selfMaps = 1; // the identity
+    for (int t = 1; t < 8; t++)
+    {
+        int order = 0; // image compared to sol, -1 smaller, 1 bigger
+        for (int i = 0; i < n && order == 0; i++)
+        {
+            // row i of the image, same cases as transformBoard
+            int c;
+            switch (t)
+            {
+            case 1:
+                c = n - 1 - inverse[i];
+                break;
+            case 2:
+                c = n - 1 - sol[n - 1 - i];
+                break;
+            case 3:
+                c = inverse[n - 1 - i];
+                break;
+            case 4:
+                c = n - 1 - sol[i];
+                break;
+            case 5:
+                c = sol[n - 1 - i];
+                break;
+            case 6:
+                c = inverse[i];
+                break;
+            default:
+                c = n - 1 - inverse[n - 1 - i];
+                break;
+            }
+
+            if (c != sol[i])
+                order = c < sol[i] ? -1 : 1;
+        }
+
+        if (order < 0)
+            return 0;
+        if (order == 0)
+            selfMaps++;
+    }
+
+    // orbit size = |D4| / |stabilizer|, so 8, 4 or 2
+    return 8 / selfMaps;
+}
+
+std::vector<Solution> expandSymmetric(const Solution &sol, SymmetryMode mode)
+{
+    std::vector<Solution> out;
+
+    if (mode == SymmetryMode::None)
+    {
+        out.push_back(sol);
+        return out;
+    }
+
+    if (mode == SymmetryMode::Mirror)
+    {
+        out.push_back(sol);
+        if (symmetryWeight(sol, mode) == 2)
+            out.push_back(transformBoard(sol, 4));
+        return out;
+    }
+
+    for (int t = 0; t < 8; t++)
+    {
+        out.push_back(transformBoard(sol, t));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+SymmetryMode parseSymmetryMode(const std::string &value)
+{
+    if (value == "mirror")
+        return SymmetryMode::Mirror;
+    if (value == "full")
+        return SymmetryMode::Full;
+    return SymmetryMode::None;
+}
+
+std::string symmetryModeName(SymmetryMode mode)
+{
+    switch (mode)
+    {
+    case SymmetryMode::Mirror:
+        return "mirror";
+    case SymmetryMode::Full:
+        return "full";
+    default:
+        return "none";
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "Solver.h"
+#include "DomainBits.h"
+#include <string>
+#include <cstdint>
+
+// helpers for symmetry breaking, shared by all solvers and main
+
+// with Mirror/Full, row 0 only gets columns [0, firstRowLimit)
+// for odd n that includes the middle column, whose solutions mirror onto themselves in row 0 and are counted once
+int firstRowLimit(int n, SymmetryMode mode);
+uint64_t firstRowMask(int n, SymmetryMode mode);
+
+// how many solutions a found board stands for, 0 means drop it (not D4 canonical)
+int symmetryWeight(const Solution &sol, SymmetryMode mode);
+
+// with Full, the columns row may still take once row 0's queen is in column firstCol
+// every rotation/reflection moves the last row, column 0 or column n-1 onto row 0, and the canonical board has the
+// smallest row 0 column of its orbit, so the queens on those three lines all sit in [firstCol, n-1-firstCol]:
+// the last row is cut to that range, and rows outside it can't use the edge columns
+// only a bound, symmetryWeight still decides at the leaf
+template <class Word>
+Word canonicalRowMask(int n, int firstCol, int row)
+{
+    Word mask = lowBits<Word>(n);
+    if (row == 0)
+        return mask;
+
+    if (row == n - 1)
+        return mask & lowBits<Word>(n - firstCol) & ~lowBits<Word>(firstCol);
+
+    if (row < firstCol || row > n - 1 - firstCol)
+    {
+        clearBit(mask, 0);
+        clearBit(mask, n - 1);
+    }
+    return mask;
+}
+
+// every solution a found board stands for, used when printing/saving so outputs stay complete
+std::vector<Solution> expandSymmetric(const Solution &sol, SymmetryMode mode);
+
+SymmetryMode parseSymmetryMode(const std::string &value);
+std::string symmetryModeName(SymmetryMode mode);
+
+#endif
@@ -0,0 +1,209 @@
+#include "WorkPool.h"
+
+WorkPool::WorkPool(int nWorkers, int64_t seedCapacity, const SearchLimit *limit)
+    : deques(nWorkers > 0 ? nWorkers : 1), nextDeque(0), queued(0), outstanding(0), idleWorkers(0), waitingSeeders(0),
+      capacity(seedCapacity), seeded(0), limit(limit) {}
+
+void WorkPool::push(const Solution &item)
+{
+    size_t target = nextDeque.fetch_add(1, std::memory_order_relaxed) % deques.size();
+    push(static_cast<int>(target), item);
+}
+
+void WorkPool::push(int workerId, const Solution &item)
+{
+    // nobody is going to solve it anymore
+    if (cancelled())
+        return;
+
+    // count before it becomes visible, so outstanding can never read 0 while work exists
+    outstanding.fetch_add(1);
+    queued.fetch_add(1);
+
+    WorkerDeque &dq = deques[workerId];
+    {
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        dq.items.push_back(item);
+    }
+
+    // seeding and donation only, an idle worker is rare enough that the check is all it costs otherwise
+    if (idleWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        workReady.notify_one();
+    }
+}
+
+void WorkPool::pushSeed(const Solution &item)
+{
+    // bounded, so a big granularity doesn't materialize every seed up front
+    if (capacity > 0 && queued.load() >= capacity)
+    {
+        waitingSeeders.fetch_add(1);
+        std::unique_lock<std::mutex> lock(waitMutex);
+        seedRoom.wait(lock, [this] { return queued.load() < capacity || cancelled(); });
+        waitingSeeders.fetch_sub(1);
+    }
+    if (cancelled())
+        return;
+
+    seeded.fetch_add(1, std::memory_order_relaxed);
+    push(item);
+}
+
+void WorkPool::beginProducer()
+{
+    outstanding.fetch_add(1);
+}
+
+void WorkPool::endProducer()
+{
+    complete();
+}
+
+bool WorkPool::popOwn(int workerId, Solution &out)
+{
+    WorkerDeque &dq = deques[workerId];
+    std::lock_guard<std::mutex> lock(dq.mutex);
+    if (dq.items.empty())
+        return false;
+
+    // LIFO for the owner, keeps the most recently pushed (deepest) work local
+    out = std::move(dq.items.back());
+    dq.items.pop_back();
+    taken();
+    return true;
+}
+
+bool WorkPool::steal(int thiefId, Solution &out)
+{
+    // every deque is empty, don't go through their locks to find out
+    if (queued.load() == 0)
+        return false;
+
+    int n = static_cast<int>(deques.size());
+
+    // start at the neighbour so thieves don't all hammer deque 0
+    for (int i = 1; i < n; i++)
+    {
+        WorkerDeque &dq = deques[(thiefId + i) % n];
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        if (dq.items.empty())
+            continue;
+
+        // FIFO for thieves, the front is the oldest (shallowest) work
+        out = std::move(dq.items.front());
+        dq.items.pop_front();
+        taken();
+        return true;
+    }
+
+    return false;
+}
+
+// an item left its deque (dq.mutex held), a seeder waiting for room may go on
+void WorkPool::taken()
+{
+    queued.fetch_sub(1);
+    if (waitingSeeders.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        seedRoom.notify_one();
+    }
+}
+
+// count items as done, the last one wakes every idle worker so they can quit
+void WorkPool::finished(int64_t count)
+{
+    if (count > 0 && outstanding.fetch_sub(count) == count)
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        workReady.notify_all();
+    }
+}
+
+// throws away everything still queued, it's never handed out so it never gets complete()d either
+// a seeder blocked on a full pool gets woken, it sees the cancel and stops
+void WorkPool::drain()
+{
+    for (auto &dq : deques)
+    {
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        int64_t dropped = static_cast<int64_t>(dq.items.size());
+        dq.items.clear();
+        queued.fetch_sub(dropped);
+        finished(dropped);
+    }
+
+    std::lock_guard<std::mutex> lock(waitMutex);
+    seedRoom.notify_all();
+}
+
+bool WorkPool::pop(int workerId, Solution &out)
+{
+    if (cancelled())
+    {
+        drain();
+        return false;
+    }
+
+    if (popOwn(workerId, out))
+        return true;
+    return steal(workerId, out);
+}
+
+bool WorkPool::acquire(int workerId, Solution &out)
+{
+    if (pop(workerId, out))
+        return true;
+
+    // nothing to pop, go idle so running solvers start donating
+    idleWorkers.fetch_add(1);
+    while (true)
+    {
+        if (pop(workerId, out))
+        {
+            idleWorkers.fetch_sub(1);
+            return true;
+        }
+
+        // nothing queued and nobody solving, nothing can be donated anymore
+        // or the run is over anyway
+        if (outstanding.load() == 0 || cancelled())
+        {
+            idleWorkers.fetch_sub(1);
+            return false;
+        }
+
+        // sleep until a push or the last complete(), idleWorkers went up first so a pusher either
+        // sees it and notifies, or pushed early enough for queued to show it here
+        std::unique_lock<std::mutex> lock(waitMutex);
+        workReady.wait(lock, [this] { return queued.load() > 0 || outstanding.load() == 0 || cancelled(); });
+    }
+}
+
+void WorkPool::complete()
+{
+    finished(1);
+}
+
+size_t WorkPool::size()
+{
+    size_t total = 0;
+    for (auto &dq : deques)
+    {
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        total += dq.items.size();
+    }
+    return total;
+}
+
+int64_t WorkPool::seedCount() const
+{
+    return seeded.load();
+}
+
+int WorkPool::workerCount() const
+{
+    return static_cast<int>(deques.size());
+}
@@ -0,0 +1,90 @@
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include "Solver.h"
+#include "SearchLimit.h"
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+// work stealing pool, replaces the single std::queue + global mutex
+// every worker owns a deque, seeds are spread round robin across them
+// owner pops from the back of its own deque, idle workers steal from the front of others
+// running solvers can also push part of their stack back in when someone is idle (donation)
+// seeds are produced while the workers run, pushSeed blocks once capacity items are queued
+// idle workers and a blocked seeder sleep on condition variables, nothing spins on the deque locks
+// once the run's SearchLimit trips, the queued items get dropped, new ones are refused and acquire() returns false
+class WorkPool
+{
+private:
+    // aligned so two workers' deques never share a cache line
+    struct alignas(64) WorkerDeque
+    {
+        std::deque<Solution> items;
+        std::mutex mutex;
+    };
+
+    std::vector<WorkerDeque> deques;
+    std::atomic<size_t> nextDeque; // round robin cursor for push without an owner
+
+    std::atomic<int64_t> queued;      // items sitting in deques
+    std::atomic<int64_t> outstanding; // items queued or still being solved, 0 means the run is over
+    std::atomic<int> idleWorkers;
+    std::atomic<int> waitingSeeders;
+
+    // idle workers wait for an item or for outstanding to hit 0, seeders wait for room below capacity
+    // waiters check under waitMutex, and wakers take it before notifying, so no wakeup gets lost in between
+    std::mutex waitMutex;
+    std::condition_variable workReady;
+    std::condition_variable seedRoom;
+
+    int64_t capacity;            // max queued seeds before pushSeed waits, 0 = unbounded
+    std::atomic<int64_t> seeded; // total seeds produced, just for reporting
+    const SearchLimit *limit;    // null = never cancelled
+
+    bool popOwn(int workerId, Solution &out);
+    bool steal(int thiefId, Solution &out);
+    bool cancelled() const
+    {
+        return limit && limit->stopRequested();
+    }
+    void drain();
+    void taken();
+    void finished(int64_t count);
+
+public:
+    WorkPool(int nWorkers, int64_t seedCapacity = 0, const SearchLimit *limit = nullptr);
+
+    // spread across deques, used by the seed solver
+    void push(const Solution &item);
+    // push onto a specific worker's deque
+    void push(int workerId, const Solution &item);
+    // producer side of the seed pipeline, waits while the pool is full
+    void pushSeed(const Solution &item);
+
+    // a running producer counts as outstanding work, so workers don't quit while it's still seeding
+    void beginProducer();
+    void endProducer();
+    // own deque first, then steal, false if every deque is empty or the run was cancelled
+    bool pop(int workerId, Solution &out);
+
+    // blocks until an item is popped/stolen (true) or no work is left anywhere or the run was cancelled (false)
+    // every item acquired has to be handed back with complete() once solved
+    bool acquire(int workerId, Solution &out);
+    void complete();
+
+    // cheap check for solvers, true when idle workers outnumber queued items
+    bool wantsWork() const
+    {
+        return queued.load(std::memory_order_relaxed) < idleWorkers.load(std::memory_order_relaxed);
+    }
+
+    size_t size();
+    int64_t seedCount() const;
+    int workerCount() const;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#!/bin/sh
+# regression check, run from the folder with the sources: sh check.sh
+# builds with ASan/UBSan and libstdc++'s bounds checks, then counts every solver type on a few board sizes,
+# reads the binary and archive output back against the text shards and checks symmetry, lazySeeding and maxSolutions
+# ASan fills fresh heap memory with junk, so search state that never gets initialized shows up as wrong counts or a report
+set -e
+src=$(pwd)
+dir=$(mktemp -d)
+g++ -std=c++17 -O1 -g -pthread -fsanitize=address,undefined -fno-sanitize-recover=undefined -D_GLIBCXX_ASSERTIONS \
+    -o "$dir/nqueens" "$src"/*.cpp
+cd "$dir"
+
+failed=0
+for type in BT BT-FC BT-FC-DVO AC3 AC3-DVO BT-BITS BT-BATCH; do
+    for threads in 1 3; do
+        for expected in 5:10 9:352 11:2680 12:14200; do
+            n=${expected%%:*}
+            printf "solverType: %s\nnThreads: %s\nboardSize: %s\nprintAllSolutions: false\nprintResultsToTxt: false\nsaveSolutionsToTxt: false\ndomainGranularity: 2\n" \
+                "$type" "$threads" "$n" > config.txt
+            got=$(./nqueens | grep "Number of Solutions" | awk '{print $NF}')
+            if [ "$got" != "${expected#*:}" ]; then
+                echo "$type, $threads threads, N=$n: got $got, expected ${expected#*:}"
+                failed=1
+            fi
+        done
+    done
+done
+
+# everything below runs in a folder of its own, results files are named after the second they got written
+# run <folder> <config lines...>: writes the config there, runs the solver in it and prints its output
+# a run that fails shows up as a wrong count instead of stopping the script
+run() {
+    mkdir -p "$dir/$1"
+    folder=$1
+    shift
+    printf "%s\n" "$@" > "$dir/$folder/config.txt"
+    (cd "$dir/$folder" && ../nqueens) || true
+}
+
+# expect <what> <got> <expected>
+expect() {
+    if [ "$2" != "$3" ]; then
+        echo "$1: got $2, expected $3"
+        failed=1
+    fi
+}
+
+count() {
+    grep "$1" | awk '{print $NF}'
+}
+
+# the solver never reads binary or archive files back, this does
+# prints every solution the way a text shard does, so the three formats can be compared line by line
+cat > "$dir/nqdump.cpp" <<'END'
+#include "PackedSolutionFile.h"
+#include "SolutionArchive.h"
+#include <iostream>
+
+static void print(const Solution &sol)
+{
+    for (int col : sol)
+        std::cout << col << ' ';
+    std::cout << '\n';
+}
+
+int main(int argc, char **argv)
+{
+    std::string filename = argv[1];
+    if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".nqa") == 0)
+    {
+        SolutionArchive archive;
+        if (!archive.load(filename))
+            return 1;
+        archive.forEach(print);
+        return 0;
+    }
+
+    PackedSolutionReader reader;
+    if (!reader.open(filename))
+        return 1;
+    for (uint64_t i = 0; i < reader.size(); i++)
+        print(reader.get(i));
+    return 0;
+}
+END
+set --
+for f in "$src"/*.cpp; do
+    [ "$(basename "$f")" = main.cpp ] || set -- "$@" "$f"
+done
+g++ -std=c++17 -O1 -g -pthread -fsanitize=address,undefined -fno-sanitize-recover=undefined -D_GLIBCXX_ASSERTIONS \
+    -I"$src" -o "$dir/nqdump" "$dir/nqdump.cpp" "$@"
+
+# one run saved as text shards, as a packed binary file and as an archive has to hold the same solutions in all three
+saved="solverType: BT-FC
+nThreads: 3
+boardSize: 9
+printResultsToTxt: true
+saveSolutionsToTxt: true
+domainGranularity: 2"
+run text "$saved" "solutionFormat: text" > /dev/null
+run binary "$saved" "solutionFormat: binary" > /dev/null
+run archive "$saved" "solutionFormat: archive" > /dev/null
+cat "$dir"/text/*.part*.txt | sort > "$dir/text.sorted"
+expect "text shards, N=9" "$(wc -l < "$dir/text.sorted" | tr -d ' ')" 352
+for file in "$dir"/binary/*.bin "$dir"/archive/*.nqa; do
+    if ! "$dir/nqdump" "$file" > "$dir/dump"; then
+        echo "$(basename "$file"): can't be read back"
+        failed=1
+    elif ! sort "$dir/dump" | cmp -s "$dir/text.sorted" -; then
+        echo "$(basename "$file"): solutions read back don't match the text shards"
+        failed=1
+    fi
+done
+
+# printing alone keeps the archive in memory too, but there's no archive file to write
+got=$(run printed "solverType: BT-FC" "nThreads: 3" "boardSize: 8" "domainGranularity: 2" "printAllSolutions: true" \
+    "printResultsToTxt: true" "saveSolutionsToTxt: false" "solutionFormat: archive")
+expect "printAllSolutions with archive, N=8" "$(echo "$got" | count "Number of Solutions")" 92
+expect "printAllSolutions with archive, N=8, printed" "$(echo "$got" | grep -c "^Solution ")" 92
+expect "printAllSolutions with archive, N=8, archive files" "$(ls "$dir"/printed | grep -c "\.nqa$")" 0
+
+# symmetry breaking still has to come out at the full count, full also reports the unique boards
+got=$(run mirror "solverType: BT-FC-DVO" "nThreads: 3" "boardSize: 12" "domainGranularity: 2" "symmetry: mirror")
+expect "symmetry mirror, N=12" "$(echo "$got" | count "Number of Solutions")" 14200
+got=$(run full "solverType: BT-BITS" "nThreads: 3" "boardSize: 12" "domainGranularity: 2" "symmetry: full")
+expect "symmetry full, N=12" "$(echo "$got" | count "Number of Solutions")" 14200
+expect "symmetry full, N=12, unique" "$(echo "$got" | count "Unique Solutions")" 1787
+
+got=$(run lazy "solverType: AC3-DVO" "nThreads: 3" "boardSize: 11" "domainGranularity: 2" "lazySeeding: true")
+expect "lazySeeding, N=11" "$(echo "$got" | count "Number of Solutions")" 2680
+
+# without symmetry every solution weighs one, so the limit is hit exactly and only that many get saved
+got=$(run limit "solverType: BT" "nThreads: 3" "boardSize: 12" "domainGranularity: 2" "maxSolutions: 100" \
+    "printResultsToTxt: true" "saveSolutionsToTxt: true")
+expect "maxSolutions 100, N=12" "$(echo "$got" | count "Number of Solutions")" 100
+expect "maxSolutions 100, N=12, saved" "$(cat "$dir"/limit/*.part*.txt | wc -l | tr -d ' ')" 100
+
+rm -rf "$dir"
+if [ $failed = 0 ]; then
+    echo "All checks pass"
+fi
+exit $failed
@@ -6,17 +6,34 @@
 #include <sstream>
 #include <chrono>
 #include <ctime>
+#include <cstdlib>
 
 #include <memory>
 #include <mutex>
-#include <queue>
-
-#include "BTSolver.h"
-#include "BTFCSolver.h"
-#include "BTFCDVOSolver.h"
-
-#include "AC3Solver.h"
-#include "AC3DVOSolver.h"
+#include <atomic>
+#include <algorithm>
+
+#include "BTBitsSolver.h"
+#include "BatchBitsSolver.h"
+#include "SearchEngine.h"
+#include "ForwardCheck.h"
+#include "RowSelect.h"
+
+#include "WorkPool.h"
+#include "SeedSpace.h"
+#include "Symmetry.h"
+#include "SolutionSink.h"
+#include "PackedSolutionFile.h"
+#include "SolutionArchive.h"
+#include "SearchLimit.h"
+
+// one engine of a PORTFOLIO mix, "BT-FC-DVO" or "BT-FC-DVO/random" in the config
+struct PortfolioEntry
+{
+    std::string name;          // as written in the config, what the results file reports as the winner
+    std::string solverType;
+    std::string valueOrdering; // empty = the run's valueOrdering
+};
 
 struct Config
 {
@@ -28,41 +45,108 @@ struct Config
     bool saveSolutionsToTxt;
     bool isParallel;
     int domainGranularity;
+    int seedThreads;       // threads generating seeds alongside the workers
+    int seedQueueCapacity; // max seeds waiting in the pool before the seeders block
+    bool lazySeeding;      // claim seeds from an index addressed seed space instead of running seeders
+    SymmetryMode symmetry;
+    bool countOnly; // count solutions without storing them, for boards where storing is impossible
+    int solutionBatchSize; // solutions each solver buffers before flushing to the output
+    std::string solutionFormat; // "text", "binary" (see PackedSolutionFile.h) or "archive" (see SolutionArchive.h) for saved solutions
+    bool incrementalAC;         // AC3 types only, see ArcConsistency in SearchPolicies.h
+    ValueOrdering valueOrdering; // engine types only, see ConfiguredValues in SearchPolicies.h
+    uint64_t randomSeed;         // for valueOrdering random, worker i seeds with randomSeed + i
+    uint64_t maxSolutions;       // stop the whole run once this many solutions are in, 0 = find them all
+                                 // counted like Number of Solutions, so with symmetry one board found counts for its copies (2 with mirror,
+                                 // up to 8 with full) and the count can pass the limit, firstOnly with mirror reports 2
+    std::vector<PortfolioEntry> portfolio; // PORTFOLIO only, the mix raced across the threads, printing/saving solutions needs maxSolutions
 };
 
 // spawn solver based on config
 // maxDepth is used for filling out the domain at the start
-std::unique_ptr<Solver> spawnSolver(const std::string &solverType, int boardSize, const Solution &initialState, int maxDepth = 0, std::queue<Solution> *workQueue = nullptr, std::mutex *queueMutex = nullptr)
+// the engine types come out specialized for boardSize when it is in [minFixedSize, maxFixedSize],
+// with multiword domains past 64 columns, see BoardSize.h
+std::unique_ptr<Solver> spawnSolver(const std::string &solverType, int boardSize, const Solution &initialState, int maxDepth = 0, WorkPool *workPool = nullptr, const SolverOptions &options = SolverOptions())
 {
-    if (solverType == "BT")
+    // the bit board solvers keep a row in one 64 bit word, past that plain BT on the engine's wide domains does the same search
+    if ((solverType == "BT-BITS" || solverType == "BT-BATCH") && boardSize > 64)
     {
-        return std::make_unique<BTSolver>(boardSize, initialState, maxDepth, workQueue, queueMutex);
+        return makeSearchEngine("BT", boardSize, initialState, maxDepth, workPool, options);
     }
-    else if (solverType == "BT-FC")
-    {
-        return std::make_unique<BTFCSolver>(boardSize, initialState, maxDepth, workQueue, queueMutex);
-    }
-    else if (solverType == "BT-FC-DVO")
+
+    if (solverType == "BT-BITS")
     {
-        return std::make_unique<BTFCDVOSolver>(boardSize, initialState, maxDepth, workQueue, queueMutex);
+        return std::make_unique<BTBitsSolver>(boardSize, initialState, maxDepth, workPool, options);
     }
-    else if (solverType == "AC3")
+
+    // the batch solver only searches, seeding and boards it can't fit go through BT-BITS, same counts either way
+    if (solverType == "BT-BATCH")
     {
-        return std::make_unique<AC3Solver>(boardSize, initialState, maxDepth, workQueue, queueMutex);
+        if (maxDepth > 0 || boardSize > BatchBitsSolver::maxBoardSize)
+            return std::make_unique<BTBitsSolver>(boardSize, initialState, maxDepth, workPool, options);
+        return std::make_unique<BatchBitsSolver>(boardSize, initialState, workPool, options);
     }
-    else if (solverType == "AC3-DVO")
+
+    if (boardSize > maxBoardSize)
     {
-        return std::make_unique<AC3DVOSolver>(boardSize, initialState, maxDepth, workQueue, queueMutex);
+        std::cout << "Error while spawning solver! Board sizes go up to " << maxBoardSize << "\n";
+        return nullptr;
     }
 
+    // everything else is a policy combination of the search engine
+    std::unique_ptr<Solver> engine = makeSearchEngine(solverType, boardSize, initialState, maxDepth, workPool, options);
+    if (engine)
+        return engine;
+
     std::cout << "Error while spawning solver! Are you sure you typed in a valid type?\n";
     return nullptr;
 }
 
+// comma separated solver types, each optionally followed by /valueOrdering
+std::vector<PortfolioEntry> parsePortfolio(const std::string &value)
+{
+    std::vector<PortfolioEntry> entries;
+    std::istringstream iss(value);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        // clean
+        item.erase(0, item.find_first_not_of(" \t\r"));
+        item.erase(item.find_last_not_of(" \t\r") + 1);
+        if (item.empty())
+            continue;
+
+        PortfolioEntry entry;
+        entry.name = item;
+        size_t slash = item.find('/');
+        entry.solverType = item.substr(0, slash);
+        if (slash != std::string::npos)
+            entry.valueOrdering = item.substr(slash + 1);
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
 Config readConfig(const std::string &filename)
 {
     Config config;
+    config.nThreads = 1;
+    config.boardSize = 0; // has to be set
+    config.printAllSolutions = false;
+    config.printResultsToTxt = false;
+    config.saveSolutionsToTxt = false;
     config.domainGranularity = 1; // by default, only populate first variable
+    config.seedThreads = 1;
+    config.seedQueueCapacity = 0; // 0 = pick from nThreads below
+    config.lazySeeding = false;
+    config.symmetry = SymmetryMode::None;
+    config.countOnly = false;
+    config.solutionBatchSize = 1024;
+    config.solutionFormat = "text";
+    config.incrementalAC = true;
+    config.valueOrdering = ValueOrdering::Ascending;
+    config.randomSeed = 1;
+    config.maxSolutions = 0;
+    config.portfolio = parsePortfolio("BT, BT-FC, BT-FC-DVO, AC3, AC3-DVO"); // every engine type once
 
     std::ifstream file(filename);
     std::string line;
@@ -76,8 +160,9 @@ Config readConfig(const std::string &filename)
         {
             std::getline(iss, value);
 
-            // clean
+            // clean, the trailing \r of a config saved on Windows isn't part of the value either
             value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t\r") + 1);
 
             if (key == "solverType")
                 config.solverType = value;
@@ -93,10 +178,76 @@ Config readConfig(const std::string &filename)
                 config.saveSolutionsToTxt = (value == "true");
             else if (key == "domainGranularity")
                 config.domainGranularity = std::stoi(value);
+            else if (key == "seedThreads")
+                config.seedThreads = std::stoi(value);
+            else if (key == "seedQueueCapacity")
+                config.seedQueueCapacity = std::stoi(value);
+            else if (key == "lazySeeding")
+                config.lazySeeding = (value == "true");
+            else if (key == "symmetry")
+            {
+                config.symmetry = parseSymmetryMode(value);
+                // parseSymmetryMode falls back to none, a typo would quietly search every board
+                if (symmetryModeName(config.symmetry) != value)
+                {
+                    std::cout << "Error: unknown symmetry " << value << ", use none, mirror or full\n";
+                    std::exit(1);
+                }
+            }
+            else if (key == "countOnly")
+                config.countOnly = (value == "true");
+            else if (key == "solutionBatchSize")
+                config.solutionBatchSize = std::stoi(value);
+            else if (key == "solutionFormat")
+            {
+                config.solutionFormat = value;
+                // anything else would fall back to text shards without a word
+                if (value != "text" && value != "binary" && value != "archive")
+                {
+                    std::cout << "Error: unknown solutionFormat " << value << ", use text, binary or archive\n";
+                    std::exit(1);
+                }
+            }
+            else if (key == "incrementalAC")
+                config.incrementalAC = (value == "true");
+            else if (key == "valueOrdering")
+            {
+                config.valueOrdering = parseValueOrdering(value);
+                // same check as a portfolio entry, parseValueOrdering falls back to ascending
+                if (valueOrderingName(config.valueOrdering) != value)
+                {
+                    std::cout << "Error: unknown valueOrdering " << value << ", use ascending, lcv, middle or random\n";
+                    std::exit(1);
+                }
+            }
+            else if (key == "randomSeed")
+                config.randomSeed = std::stoull(value);
+            else if (key == "maxSolutions")
+                config.maxSolutions = std::stoull(value);
+            else if (key == "firstOnly" && value == "true")
+                config.maxSolutions = 1;
+            else if (key == "portfolio")
+                config.portfolio = parsePortfolio(value);
         }
     }
 
+    // the biggest word type covers maxBoardSize columns, see BoardSize.h
+    if (config.boardSize < 1 || config.boardSize > maxBoardSize)
+    {
+        std::cout << "Error: boardSize has to be between 1 and " << maxBoardSize << ", got " << config.boardSize << "\n";
+        std::exit(1);
+    }
+    if (config.solutionBatchSize < 1)
+    {
+        std::cout << "Error: solutionBatchSize has to be at least 1, got " << config.solutionBatchSize << "\n";
+        std::exit(1);
+    }
+
     config.isParallel = (config.nThreads > 1);
+    if (config.seedThreads < 1)
+        config.seedThreads = 1;
+    if (config.seedQueueCapacity <= 0)
+        config.seedQueueCapacity = 64 * config.nThreads; // enough to keep every worker fed
     return config;
 }
 
@@ -126,30 +277,69 @@ void printSolution(const Solution &sol)
     std::cout << "\n";
 }
 
-void writeResultsToFile(const Config &config, const std::vector<Solution> &solutions, double timeToFirst, double timeToAll)
+// the limit counts solutions weighted by symmetry, the same way Number of Solutions does,
+// so with symmetry on, the summary says why the count can be past maxSolutions
+std::string limitSummary(const Config &config)
+{
+    if (config.symmetry == SymmetryMode::None)
+        return "Stopped at the solution limit";
+    std::string copies = config.symmetry == SymmetryMode::Mirror ? "its mirror image" : "all its rotations and reflections";
+    return "Stopped at the solution limit (counted with symmetry, each board found also counts " + copies + ", so the count can pass Max Solutions)";
+}
+
+// the solutions were already streamed into bodyFiles while solving, this file only gets the header and points at them:
+// the text shard of every worker, or the one binary/archive file
+// winner is the PORTFOLIO entry that won the race and nRacers how many raced, empty and 0 for every other solver type
+// stoppedAtLimit is set when maxSolutions cut the run short
+void writeResultsToFile(const Config &config, const std::string &filename, const std::vector<std::string> &bodyFiles, uint64_t solutionCount, uint64_t uniqueCount, double timeToFirst, double timeToAll, const std::string &winner, int nRacers, bool stoppedAtLimit)
 {
-    std::string filename = config.solverType + "-" + getCurrentTimestamp() + ".txt";
     std::ofstream file(filename);
 
     file << "Solver Type: " << config.solverType << "\n";
-    file << "Threads: " << config.nThreads << "\n";
+    file << "Threads: " << (nRacers > 0 ? nRacers : config.nThreads) << "\n";
     file << "Board Size: " << config.boardSize << "\n";
     file << "Domain Granularity: " << config.domainGranularity << "\n";
+    file << "Symmetry: " << symmetryModeName(config.symmetry) << "\n";
+    file << "Count Only: " << (config.countOnly ? "true" : "false") << "\n";
+    // the bit board solvers have no value ordering, same as the console summary
+    if (config.solverType != "BT-BITS" && config.solverType != "BT-BATCH")
+        file << "Value Ordering: " << valueOrderingName(config.valueOrdering) << "\n";
+    if (config.maxSolutions > 0)
+        file << "Max Solutions: " << config.maxSolutions << "\n";
+    if (!winner.empty())
+    {
+        file << "Portfolio:";
+        for (int i = 0; i < nRacers; i++)
+            file << (i ? ", " : " ") << config.portfolio[i % config.portfolio.size()].name;
+        file << "\n";
+        file << "Portfolio Winner: " << winner << "\n";
+    }
     file << "Time to First Solution: " << timeToFirst << " seconds\n";
     file << "Time to All Solutions: " << timeToAll << " seconds\n";
-    file << "Number of Solutions: " << solutions.size() << "\n\n";
-
-    if (config.saveSolutionsToTxt)
+    file << "Number of Solutions: " << solutionCount << "\n";
+    if (stoppedAtLimit)
+        file << limitSummary(config) << "\n";
+    if (config.symmetry == SymmetryMode::Full)
+        file << "Unique Solutions: " << uniqueCount << "\n";
+    file << "\n";
+
+    if (config.saveSolutionsToTxt && config.countOnly)
+    {
+        file << "All Solutions: not stored (countOnly)\n";
+    }
+    else if (config.saveSolutionsToTxt && (config.solutionFormat == "binary" || config.solutionFormat == "archive"))
+    {
+        // packed records / the archive are in their own file, see PackedSolutionReader and SolutionArchive::load
+        file << "All Solutions: " << bodyFiles[0] << " (" << config.solutionFormat << ")\n";
+    }
+    else if (config.saveSolutionsToTxt)
     {
-        file << "All Solutions:\n";
-        for (size_t i = 0; i < solutions.size(); i++)
+        // every worker wrote its own shard while solving, they stay where they are,
+        // stitching them in here would put all the output I/O back on one thread after the run
+        file << "All Solutions: " << bodyFiles.size() << " text shard" << (bodyFiles.size() == 1 ? "" : "s") << ", one solution per line\n";
+        for (const std::string &bodyFilename : bodyFiles)
         {
-            for (int col : solutions[i])
-            {
-                // don't print visually, makes massive outputs. just do raw variables
-                file << col << " ";
-            }
-            file << "\n";
+            file << bodyFilename << "\n";
         }
     }
 
@@ -157,101 +347,469 @@ void writeResultsToFile(const Config &config, const std::vector<Solution> &solut
     std::cout << "Results written to " << filename << "\n";
 }
 
-// pop from primary work queue + allocate solver + start solve + loop if work queue not empty
-void workerThread(std::queue<Solution> *workQueue, std::mutex *queueMutex, const Config &config, std::vector<std::unique_ptr<Solver>> *solvers, std::mutex *solversMutex)
+SolverOptions solverOptions(const Config &config, SolutionSink *sink)
+{
+    SolverOptions options;
+    options.symmetry = config.symmetry;
+    options.countOnly = config.countOnly;
+    options.sink = sink;
+    options.sinkBatchSize = config.solutionBatchSize;
+    options.incrementalAC = config.incrementalAC;
+    options.valueOrdering = config.valueOrdering;
+    return options;
+}
+
+// pop from own deque (or steal from another worker) + solve + loop until no work is left
+// with a lazy seed space, donations come first, then index ranges get claimed from the seed space
+// every worker owns one solver for the whole run, re-armed per seed, its counts add up to this worker's results
+void workerThread(int workerId, WorkPool *workPool, SeedSpace *seedSpace, const Config &config, const SolverOptions *options, std::unique_ptr<Solver> *result)
 {
+    Solution initialState(config.boardSize, -1);
+
+    // pass the pool down so this solver can donate if another worker goes idle
+    std::unique_ptr<Solver> solver = spawnSolver(config.solverType, config.boardSize, initialState, 0, workPool, *options);
+    if (!solver)
+        return;
+    const SearchLimit *limit = options->limit;
+
     while (true)
     {
-        Solution initialState;
-
-        // pop work from queue
+        // once the solution limit is reached the seed space has nothing more to hand out, acquire() below
+        // drops what the pool still holds and returns false
+        if (seedSpace && (!limit || !limit->stopRequested()))
         {
-            std::lock_guard<std::mutex> lock(*queueMutex);
-            if (workQueue->empty())
+            if (workPool->pop(workerId, initialState))
+            {
+                solver->reset(initialState);
+                solver->solve();
+                workPool->complete();
+                continue;
+            }
+
+            // registered before claiming, our solvers may still donate so idle workers must not quit yet
+            workPool->beginProducer();
+            uint64_t cursor, end;
+            if (seedSpace->claim(cursor, end))
             {
-                break; // wq empty
+                // seeds only become boards here, one at a time, reusing the same buffer
+                initialState.assign(config.boardSize, -1);
+                while ((!limit || !limit->stopRequested()) && seedSpace->next(cursor, end, initialState))
+                {
+                    solver->reset(initialState);
+                    solver->solve();
+                }
+                workPool->endProducer();
+                continue;
             }
-            initialState = workQueue->front();
-            workQueue->pop();
+            workPool->endProducer();
         }
 
-        auto solver = spawnSolver(config.solverType, config.boardSize, initialState);
+        // no lock shared by all workers here, only the deque being popped/stolen from
+        // waits while other workers are still running, they may donate part of their stack
+        if (!workPool->acquire(workerId, initialState))
+        {
+            break; // no work left anywhere
+        }
+
+        solver->reset(initialState);
         solver->solve();
+        workPool->complete();
+    }
 
-        // double check if locking is proper
+    // each worker only writes its own slot, nothing to lock
+    *result = std::move(solver);
+}
+
+// one racer of a PORTFOLIO run, solves the whole board on its own, no pool and no seeds
+// the first one to finish (its solution limit reached or the whole space searched) claims the win and cancels the others,
+// the winner is claimed before anybody gets cancelled, so a racer that was stopped halfway can never claim it
+void portfolioThread(int racerId, const std::string &solverType, const Config &config, const SolverOptions *options,
+                     const std::vector<std::unique_ptr<SearchLimit>> *limits, std::atomic<int> *winner, std::unique_ptr<Solver> *result)
+{
+    Solution initialState(config.boardSize, -1);
+    std::unique_ptr<Solver> solver = spawnSolver(solverType, config.boardSize, initialState, 0, nullptr, *options);
+    if (!solver)
+        return;
+
+    solver->solve();
+
+    int none = -1;
+    if (winner->compare_exchange_strong(none, racerId))
+    {
+        for (size_t i = 0; i < limits->size(); i++)
         {
-            std::lock_guard<std::mutex> lock(*solversMutex);
-            solvers->push_back(std::move(solver));
+            if (static_cast<int>(i) != racerId)
+                (*limits)[i]->cancel();
         }
     }
+
+    *result = std::move(solver);
+}
+
+// seed generator, runs alongside the workers and streams seeds into the bounded pool
+// the first row's columns are split across seeders, each one expands its roots to domainGranularity
+void seedThread(int seederId, WorkPool *workPool, const Config &config, const SolverOptions *options)
+{
+    // symmetry breaking only lets row 0 take the left half
+    int rowZeroLimit = firstRowLimit(config.boardSize, config.symmetry);
+    Solution root(config.boardSize, -1);
+    std::unique_ptr<Solver> seedSolver; // one per seeder, re-armed per root
+    for (int col = seederId; col < rowZeroLimit; col += config.seedThreads)
+    {
+        if (options->limit && options->limit->stopRequested())
+            break;
+
+        root.assign(config.boardSize, -1);
+        root[0] = col;
+
+        // granularity 1 means the roots are the seeds
+        if (config.domainGranularity <= 1)
+        {
+            workPool->pushSeed(root);
+            continue;
+        }
+
+        if (!seedSolver)
+            seedSolver = spawnSolver(config.solverType, config.boardSize, root,
+                                     config.domainGranularity, workPool, *options);
+        if (!seedSolver)
+            break;
+        seedSolver->reset(root);
+        seedSolver->solve();
+    }
+
+    workPool->endProducer();
 }
 
 int main()
 {
     Config config = readConfig("config.txt");
 
+    // a portfolio races whole-board solvers against each other instead of splitting the board between workers
+    bool portfolio = (config.solverType == "PORTFOLIO");
+    int nRacers = portfolio ? std::max(config.nThreads, 1) : 0;
+    if (portfolio && config.portfolio.empty())
+    {
+        std::cout << "Error: the portfolio is empty\n";
+        return 1;
+    }
+    for (size_t i = 0; portfolio && i < config.portfolio.size(); i++)
+    {
+        const PortfolioEntry &entry = config.portfolio[i];
+        if (!spawnSolver(entry.solverType, config.boardSize, Solution(config.boardSize, -1)))
+        {
+            std::cout << "Error: portfolio entry " << entry.name << " isn't a solver type that can race\n";
+            return 1;
+        }
+        if (entry.valueOrdering.empty())
+            continue;
+        // the bit board solvers have no value ordering to set
+        if (entry.solverType == "BT-BITS" || entry.solverType == "BT-BATCH")
+        {
+            std::cout << "Error: portfolio entry " << entry.name << " sets a value ordering, " << entry.solverType << " doesn't have one\n";
+            return 1;
+        }
+        // parseValueOrdering falls back to ascending, only a real name survives the round trip
+        if (valueOrderingName(parseValueOrdering(entry.valueOrdering)) != entry.valueOrdering)
+        {
+            std::cout << "Error: portfolio entry " << entry.name << " has an unknown value ordering, use ascending, lcv, middle or random\n";
+            return 1;
+        }
+    }
+    // one racer per thread, entries past that never run
+    if (portfolio && config.portfolio.size() > static_cast<size_t>(nRacers))
+    {
+        std::cout << "Warning: only " << nRacers << " thread(s) for " << config.portfolio.size() << " portfolio entries, not racing:";
+        for (size_t i = nRacers; i < config.portfolio.size(); i++)
+            std::cout << (i > static_cast<size_t>(nRacers) ? ", " : " ") << config.portfolio[i].name;
+        std::cout << "\n";
+    }
+
+    // racers can't stream into the real output (only the winner's solutions may end up there), so each one
+    // keeps its solutions in memory until the race is over, fine under a limit but not for a full enumeration
+    bool keepSolutions = !config.countOnly && (config.printAllSolutions || (config.printResultsToTxt && config.saveSolutionsToTxt));
+    if (portfolio && keepSolutions && config.maxSolutions == 0)
+    {
+        std::cout << "Error: PORTFOLIO buffers every racer's solutions in memory, set maxSolutions or firstOnly "
+                  << "to print or save its solutions, or countOnly\n";
+        return 1;
+    }
+
+    // a solver type that can't be spawned stops the run here, before any thread depends on it
+    if (!portfolio && !spawnSolver(config.solverType, config.boardSize, Solution(config.boardSize, -1)))
+        return 1;
+
     std::cout << "N-Queens Solver" << "\n";
     std::cout << "- Solver: " << config.solverType << "\n";
     std::cout << "- Board Size: " << config.boardSize << "\n";
     std::cout << "- Parallel: " << (config.isParallel ? "Yes" : "No") << "\n";
     // std::cout << "- Domain Granularity: " << config.domainGranularity << "\n";
-    if (config.isParallel)
+    if (portfolio)
+    {
+        // entries get handed out round robin, with more threads than entries the repeats only differ by their random seed
+        std::cout << "- Threads: " << nRacers << "\n";
+        std::cout << "- Portfolio:";
+        for (int i = 0; i < nRacers; i++)
+            std::cout << (i ? ", " : " ") << config.portfolio[i % config.portfolio.size()].name;
+        std::cout << "\n";
+    }
+    else if (config.isParallel)
     {
         std::cout << "- Threads: " << config.nThreads << "\n";
         std::cout << "- Domain Granularity: " << config.domainGranularity << "\n";
+        std::cout << "- Seed Threads: " << config.seedThreads << "\n";
+    }
+    if (config.symmetry != SymmetryMode::None)
+        std::cout << "- Symmetry: " << symmetryModeName(config.symmetry) << "\n";
+    if (config.countOnly)
+        std::cout << "- Count Only: Yes\n";
+    if (config.maxSolutions > 0)
+        std::cout << "- Max Solutions: " << config.maxSolutions << "\n";
+    if (!config.incrementalAC && config.solverType.rfind("AC3", 0) == 0)
+        std::cout << "- Incremental AC: No\n";
+    if (config.valueOrdering != ValueOrdering::Ascending && config.solverType != "BT-BITS" && config.solverType != "BT-BATCH")
+        std::cout << "- Value Ordering: " << valueOrderingName(config.valueOrdering) << "\n";
+    // the bit board solvers hand boards they can't fit to another solver, see spawnSolver, so say which one really runs
+    bool bitBoards = (config.solverType == "BT-BITS" || config.solverType == "BT-BATCH");
+    if (bitBoards && config.boardSize > 64)
+        std::cout << "- Runs As: BT (boards past 64 don't fit a word)\n";
+    else if (config.solverType == "BT-BATCH" && config.boardSize > BatchBitsSolver::maxBoardSize)
+        std::cout << "- Runs As: BT-BITS (boards past " << BatchBitsSolver::maxBoardSize << " don't fit the lanes)\n";
+    else if (config.solverType == "BT-BATCH")
+        std::cout << "- Batch Lanes: " << BatchBitsSolver::width() << " (" << BatchBitsSolver::kernelName() << ")\n";
+    else if (config.solverType != "BT" && config.solverType != "BT-BITS" && config.boardSize <= 64)
+    {
+        std::cout << "- Forward Check Kernel: " << forwardCheckKernelName() << "\n";
+        if (config.solverType.find("DVO") != std::string::npos)
+            std::cout << "- MRV Kernel: " << minDomainRowKernelName() << "\n";
     }
     std::cout << "\n";
 
+    // solutions stream out of the solvers as they're found, into memory only if they have to be printed
+    // and straight to disk if they have to be saved
+    std::string resultsStem = config.solverType + "-" + getCurrentTimestamp();
+    std::string resultsFilename = resultsStem + ".txt";
+    bool saveSolutions = config.printResultsToTxt && config.saveSolutionsToTxt;
+    bool binaryOutput = (config.solutionFormat == "binary");
+    bool archiveOutput = (config.solutionFormat == "archive");
+    // every worker gets its own sink: text goes to a per worker shard file, binary records get
+    // pwrite'd at reserved offsets of one file, so output I/O overlaps with the search and scales with threads
+    // a portfolio only keeps the winner's solutions, those go out through the first sink
+    int nWorkers = (config.isParallel && !portfolio) ? config.nThreads : 1;
+    std::vector<std::string> bodyFiles;
+    std::unique_ptr<ArchiveSink> archiveSink; // in memory, compressed, used for printing and/or the archive file
+    std::vector<std::unique_ptr<TextFileSink>> textShards;
+    std::unique_ptr<BinaryFileSink> binarySink;
+    std::vector<TeeSink> workerSinks(nWorkers);
+    if (!config.countOnly)
+    {
+        if (config.printAllSolutions || (saveSolutions && archiveOutput))
+        {
+            archiveSink = std::make_unique<ArchiveSink>(config.boardSize);
+        }
+
+        if (saveSolutions && archiveOutput)
+        {
+            // already covered by archiveSink, saved once the run is over
+            bodyFiles.push_back(resultsStem + ".nqa");
+        }
+        else if (saveSolutions && binaryOutput)
+        {
+            bodyFiles.push_back(resultsStem + ".bin");
+            binarySink = std::make_unique<BinaryFileSink>(bodyFiles[0], config.boardSize, config.solverType, config.symmetry);
+            if (!binarySink->good())
+            {
+                std::cout << "Error: can't open " << bodyFiles[0] << " for writing\n";
+                return 1;
+            }
+        }
+        else if (saveSolutions)
+        {
+            for (int i = 0; i < nWorkers; i++)
+            {
+                bodyFiles.push_back(resultsStem + ".part" + std::to_string(i) + ".txt");
+                textShards.push_back(std::make_unique<TextFileSink>(bodyFiles.back()));
+                if (!textShards.back()->good())
+                {
+                    std::cout << "Error: can't open " << bodyFiles.back() << " for writing\n";
+                    return 1;
+                }
+            }
+        }
+
+        for (int i = 0; i < nWorkers; i++)
+        {
+            if (archiveSink)
+                workerSinks[i].add(archiveSink.get());
+            if (binarySink)
+                workerSinks[i].add(binarySink.get());
+            if (!textShards.empty())
+                workerSinks[i].add(textShards[i].get());
+        }
+    }
+
+    // shared by every solver, seeder and the pool, only there when the run can stop early
+    std::unique_ptr<SearchLimit> limit;
+    if (config.maxSolutions > 0 && !portfolio)
+        limit = std::make_unique<SearchLimit>(config.maxSolutions);
+
+    std::vector<SolverOptions> workerOptions;
+    for (int i = 0; i < nWorkers; i++)
+    {
+        workerOptions.push_back(solverOptions(config, workerSinks[i].empty() ? nullptr : &workerSinks[i]));
+        workerOptions.back().randomSeed = config.randomSeed + i;
+        workerOptions.back().limit = limit.get();
+    }
+
     auto startTime = std::chrono::high_resolution_clock::now();
-    std::vector<Solution> allSolutions;
+    uint64_t solutionCount = 0; // weighted by symmetry
+    uint64_t uniqueCount = 0;
     std::chrono::high_resolution_clock::time_point firstSolutionTime;
+    bool stoppedAtLimit = false;
+    std::string winnerName;
 
-    // if threads > 1, make work queue, init a solver with depth = domainGrnularity to populate wq
-    // then, init nThreads workThreads
-    if (config.isParallel)
+    // every racer gets its own solution limit (they each search the whole board) and its own in memory sink,
+    // the winner's solutions are replayed into the real output once the race is over,
+    // which is why solutions are only kept under maxSolutions (checked up front)
+    if (portfolio)
     {
-        std::queue<Solution> workQueue;
-        std::mutex queueMutex;
+        std::vector<std::unique_ptr<SearchLimit>> limits;
+        std::vector<std::unique_ptr<ArchiveSink>> racerSinks;
+        std::vector<SolverOptions> racerOptions;
+        for (int i = 0; i < nRacers; i++)
+        {
+            const PortfolioEntry &entry = config.portfolio[i % config.portfolio.size()];
+            limits.push_back(std::make_unique<SearchLimit>(config.maxSolutions));
+            racerSinks.push_back(workerSinks[0].empty() ? nullptr : std::make_unique<ArchiveSink>(config.boardSize));
+
+            racerOptions.push_back(solverOptions(config, racerSinks.back().get()));
+            racerOptions.back().randomSeed = config.randomSeed + i;
+            racerOptions.back().limit = limits.back().get();
+            if (!entry.valueOrdering.empty())
+                racerOptions.back().valueOrdering = parseValueOrdering(entry.valueOrdering);
+        }
 
-        Solution baseState(config.boardSize, -1);
-        auto seedSolver = spawnSolver(config.solverType, config.boardSize, baseState,
-                                      config.domainGranularity, &workQueue, &queueMutex);
-        seedSolver->solve();
+        std::atomic<int> winner(-1);
+        std::vector<std::unique_ptr<Solver>> solvers(nRacers);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < nRacers; i++)
+        {
+            threads.emplace_back(portfolioThread, i, std::cref(config.portfolio[i % config.portfolio.size()].solverType), std::ref(config),
+                                 &racerOptions[i], &limits, &winner, &solvers[i]);
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
 
-        std::cout << "Work queue populated with " << workQueue.size() << " initial states\n \n";
+        // nobody wins if none of the racers could be spawned, the entries were all probed up front so this shouldn't happen
+        int w = winner.load();
+        if (w == -1)
+        {
+            std::cout << "Error: none of the portfolio racers could be spawned\n";
+            return 1;
+        }
 
-        std::vector<std::unique_ptr<Solver>> solvers;
-        std::mutex solversMutex;
+        winnerName = config.portfolio[w % config.portfolio.size()].name;
+        std::cout << "Portfolio winner: " << winnerName << " (thread " << w << ")\n \n";
+
+        solutionCount = solvers[w]->getSolutionCount();
+        uniqueCount = solvers[w]->getUniqueCount();
+        firstSolutionTime = solvers[w]->getFirstSolutionTime();
+        stoppedAtLimit = limits[w]->stopRequested();
+
+        if (racerSinks[w])
+        {
+            std::vector<Solution> batch;
+            racerSinks[w]->getArchive().forEach([&](const Solution &sol)
+            {
+                batch.push_back(sol);
+                if (batch.size() >= static_cast<size_t>(config.solutionBatchSize))
+                {
+                    workerSinks[0].consume(batch);
+                    batch.clear();
+                }
+            });
+            if (!batch.empty())
+                workerSinks[0].consume(batch);
+        }
+    }
+
+    // if threads > 1, make work pool, start seedThreads seeders with depth = domainGrnularity to populate it
+    // and nThreads workThreads at the same time, so solving overlaps with seeding
+    else if (config.isParallel)
+    {
+        // one deque per worker, seeds get spread round robin
+        WorkPool workPool(config.nThreads, config.seedQueueCapacity, limit.get());
+
+        // lazy seeding needs no seeder threads, workers decode seeds straight from their index
+        std::unique_ptr<SeedSpace> seedSpace;
+        if (config.lazySeeding)
+        {
+            seedSpace = std::make_unique<SeedSpace>(config.boardSize, config.domainGranularity, config.nThreads,
+                                                    firstRowLimit(config.boardSize, config.symmetry));
+        }
+
+        // register the seeders before any worker starts, or a worker could see an empty pool and quit
+        std::vector<std::thread> seeders;
+        int nSeeders = seedSpace ? 0 : config.seedThreads;
+        for (int i = 0; i < nSeeders; i++)
+        {
+            workPool.beginProducer();
+        }
+        for (int i = 0; i < nSeeders; i++)
+        {
+            // seed solvers stop at domainGranularity, they only emit solutions if that's the whole board
+            seeders.emplace_back(seedThread, i, &workPool, std::ref(config), &workerOptions[0]);
+        }
+
+        // one slot per worker, filled with that worker's solver once it runs out of work
+        std::vector<std::unique_ptr<Solver>> solvers(config.nThreads);
         std::vector<std::thread> threads;
         for (int i = 0; i < config.nThreads; i++)
         {
-            threads.emplace_back(workerThread, &workQueue, &queueMutex, std::ref(config), &solvers, &solversMutex);
+            threads.emplace_back(workerThread, i, &workPool, seedSpace.get(), std::ref(config), &workerOptions[i], &solvers[i]);
+        }
+
+        for (auto &seeder : seeders)
+        {
+            seeder.join();
         }
 
+        if (!seedSpace)
+            std::cout << "Work pool was fed " << workPool.seedCount() << " initial states\n \n";
+
         for (auto &thread : threads)
         {
             thread.join();
         }
 
-        // compile solutions from all solvers
+        if (seedSpace)
+            std::cout << "Seed space of " << seedSpace->size() << " indices (depth " << seedSpace->getDepth() << ") decoded "
+                      << seedSpace->decodedCount() << " initial states\n \n";
+
+        // compile solutions from all workers
         bool foundFirst = false;
         for (auto &solver : solvers)
         {
-            // std::vector<Solution> &solutions = solver->getSolutions();
-            const std::vector<Solution> &solutions = solver->getSolutions();
-            allSolutions.insert(allSolutions.end(), solutions.begin(), solutions.end());
+            if (!solver)
+                continue;
+
+            solutionCount += solver->getSolutionCount();
+            uniqueCount += solver->getUniqueCount();
 
             // yoink the fastest first sol from all solvers
 
             // you have to check if solutions empty, bc otherwise, it crashes if nStates < initial domains,
             // or the initial domain it gets ends up being a dead end
             // if (!foundFirst)
-            if (!foundFirst && !solutions.empty())
+            if (!foundFirst && solver->getSolutionCount() > 0)
             {
                 firstSolutionTime = solver->getFirstSolutionTime();
                 foundFirst = true;
             }
-            else if (!solutions.empty())
+            else if (solver->getSolutionCount() > 0)
             {
                 if (solver->getFirstSolutionTime() < firstSolutionTime)
                     firstSolutionTime = solver->getFirstSolutionTime();
@@ -263,14 +821,19 @@ int main()
     else
     {
         Solution initialState(config.boardSize, -1);
-        auto solver = spawnSolver(config.solverType, config.boardSize, initialState);
+        auto solver = spawnSolver(config.solverType, config.boardSize, initialState, 0, nullptr, workerOptions[0]);
+        if (!solver)
+            return 1;
         solver->solve();
 
-        allSolutions = solver->getSolutions();
+        solutionCount = solver->getSolutionCount();
+        uniqueCount = solver->getUniqueCount();
         firstSolutionTime = solver->getFirstSolutionTime();
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
+    if (limit)
+        stoppedAtLimit = limit->stopRequested();
 
     // double timeToFirst = std::chrono::duration<double>(firstSolutionTime - startTime);
     double timeToFirst = std::chrono::duration<double>(firstSolutionTime - startTime).count();
@@ -279,22 +842,57 @@ int main()
     // results
     std::cout << "Time to First Solution: " << timeToFirst << " seconds\n";
     std::cout << "Time to All Solutions: " << timeToAll << " seconds\n";
-    std::cout << "Number of Solutions: " << allSolutions.size() << "\n\n";
+    std::cout << "Number of Solutions: " << solutionCount << "\n";
+    if (stoppedAtLimit)
+        std::cout << limitSummary(config) << "\n";
+    if (config.symmetry == SymmetryMode::Full)
+        std::cout << "Unique Solutions: " << uniqueCount << "\n";
+    std::cout << "\n";
 
-    if (config.printAllSolutions)
+    if (config.printAllSolutions && config.countOnly)
+    {
+        std::cout << "All Solutions: not stored (countOnly)\n\n";
+    }
+    else if (config.printAllSolutions)
     {
         std::cout << "All Solutions: \n\n";
-        for (size_t i = 0; i < allSolutions.size(); i++)
+        uint64_t printed = 0;
+        archiveSink->getArchive().forEach([&printed](const Solution &sol)
         {
-            std::cout << "Solution " << (i + 1) << ":\n";
-            printSolution(allSolutions[i]);
-        }
+            std::cout << "Solution " << (++printed) << ":\n";
+            printSolution(sol);
+        });
     }
 
     if (config.printResultsToTxt)
     {
-        writeResultsToFile(config, allSolutions, timeToFirst, timeToAll);
+        // a solution file that didn't make it to disk fails the run, the counts above are still right
+        bool saved = true;
+        std::string failedFile = bodyFiles.empty() ? std::string() : bodyFiles[0];
+        for (size_t i = 0; i < textShards.size(); i++)
+        {
+            textShards[i]->close();
+            if (saved && !textShards[i]->good())
+            {
+                saved = false;
+                failedFile = bodyFiles[i];
+            }
+        }
+        if (binarySink)
+        {
+            binarySink->close();
+            saved = binarySink->good();
+        }
+        // archiveSink can also be there just for printAllSolutions, only a saved run has an archive file
+        if (archiveSink && saveSolutions && archiveOutput)
+            saved = archiveSink->getArchive().save(bodyFiles[0], config.solverType, config.symmetry);
+        if (!saved)
+        {
+            std::cout << "Error: writing " << failedFile << " failed, the file is incomplete\n";
+            return 1;
+        }
+        writeResultsToFile(config, resultsFilename, bodyFiles, solutionCount, uniqueCount, timeToFirst, timeToAll, winnerName, nRacers, stoppedAtLimit);
     }
 
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file